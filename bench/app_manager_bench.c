@@ -0,0 +1,509 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <app_manager.h>
+#include <app_manager_deprecated.h>
+
+#include <fake_backend.h>
+
+#define BENCH_APP_ID_MAX 128
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+typedef struct {
+	int running;
+	int installed;
+	int iterations;
+	int foreach_iterations;
+	unsigned int ipc_latency;
+	const char *index;
+	const char *output;
+} bench_options_s;
+
+typedef struct {
+	const char *name;
+	bool foreach;
+	void (*run)(int index);
+} bench_case_s;
+
+typedef struct {
+	unsigned long long *samples;
+	int count;
+	unsigned long allocs;
+} bench_result_s;
+
+static bench_options_s options = {
+	.running = 100,
+	.installed = 1000,
+	.iterations = 10000,
+	.foreach_iterations = 100,
+	.ipc_latency = 0,
+	.index = NULL,
+	.output = NULL,
+};
+
+static volatile unsigned long alloc_count = 0;
+
+// every allocation made by the library, GLib and the fake backend goes through these
+void *malloc(size_t size)
+{
+	__sync_fetch_and_add(&alloc_count, 1);
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+	__sync_fetch_and_add(&alloc_count, 1);
+	return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	__sync_fetch_and_add(&alloc_count, 1);
+	return __libc_realloc(ptr, size);
+}
+
+static unsigned long long bench_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (unsigned long long)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void bench_running_app_id(int index, char *buffer, int size)
+{
+	fake_backend_app_id(index % options.running, buffer, size);
+}
+
+static void bench_installed_app_id(int index, char *buffer, int size)
+{
+	fake_backend_app_id(index % options.installed, buffer, size);
+}
+
+static void bench_get_app_context(int index)
+{
+	char app_id[BENCH_APP_ID_MAX];
+	app_context_h app_context;
+
+	bench_running_app_id(index, app_id, sizeof(app_id));
+
+	if (app_manager_get_app_context(app_id, &app_context) == APP_MANAGER_ERROR_NONE)
+	{
+		app_context_destroy(app_context);
+	}
+}
+
+static bool bench_foreach_app_context_cb(app_context_h app_context, void *user_data)
+{
+	return true;
+}
+
+static void bench_foreach_app_context(int index)
+{
+	app_manager_foreach_app_context(bench_foreach_app_context_cb, NULL);
+}
+
+static bool bench_foreach_app_info_cb(app_info_h app_info, void *user_data)
+{
+	return true;
+}
+
+static void bench_foreach_app_info(int index)
+{
+	app_manager_foreach_app_info(bench_foreach_app_info_cb, NULL);
+}
+
+static bool bench_foreach_app_info_get_cb(app_info_h app_info, void *user_data)
+{
+	char *app_id = NULL;
+	char *name = NULL;
+	char *version = NULL;
+	char *icon = NULL;
+
+	app_info_get_app_id(app_info, &app_id);
+	app_info_get_name(app_info, &name);
+	app_info_get_version(app_info, &version);
+	app_info_get_icon(app_info, &icon);
+
+	free(app_id);
+	free(name);
+	free(version);
+	free(icon);
+
+	return true;
+}
+
+static void bench_foreach_app_info_get(int index)
+{
+	app_manager_foreach_app_info(bench_foreach_app_info_get_cb, NULL);
+}
+
+static bool bench_foreach_app_info_peek_cb(app_info_h app_info, void *user_data)
+{
+	const char *value;
+
+	app_info_get_app_id_peek(app_info, &value);
+	app_info_get_name_peek(app_info, &value);
+	app_info_get_version_peek(app_info, &value);
+	app_info_get_icon_peek(app_info, &value);
+
+	return true;
+}
+
+static void bench_foreach_app_info_peek(int index)
+{
+	app_manager_foreach_app_info(bench_foreach_app_info_peek_cb, NULL);
+}
+
+static void bench_get_app_id(int index)
+{
+	char *app_id;
+
+	if (app_manager_get_app_id(1000 + index % options.running, &app_id) == APP_MANAGER_ERROR_NONE)
+	{
+		free(app_id);
+	}
+}
+
+static void bench_is_running(int index)
+{
+	char app_id[BENCH_APP_ID_MAX];
+	bool running;
+
+	bench_installed_app_id(index, app_id, sizeof(app_id));
+
+	app_manager_is_running(app_id, &running);
+}
+
+static app_context_h bench_app_context = NULL;
+
+static void bench_app_context_is_terminated(int index)
+{
+	bool terminated;
+
+	app_context_is_terminated(bench_app_context, &terminated);
+}
+
+static void bench_get_app_info(int index)
+{
+	char app_id[BENCH_APP_ID_MAX];
+	app_info_h app_info;
+	const char *name;
+
+	bench_installed_app_id(index, app_id, sizeof(app_id));
+
+	if (app_manager_get_app_info(app_id, &app_info) == APP_MANAGER_ERROR_NONE)
+	{
+		app_info_get_name_peek(app_info, &name);
+		app_info_destroy(app_info);
+	}
+}
+
+static void bench_get_app_name(int index)
+{
+	char app_id[BENCH_APP_ID_MAX];
+	char *name;
+
+	bench_installed_app_id(index, app_id, sizeof(app_id));
+
+	if (app_manager_get_app_name(app_id, &name) == APP_MANAGER_ERROR_NONE)
+	{
+		free(name);
+	}
+}
+
+static void bench_get_app_icon_path(int index)
+{
+	char app_id[BENCH_APP_ID_MAX];
+	char *icon_path;
+
+	bench_installed_app_id(index, app_id, sizeof(app_id));
+
+	if (app_manager_get_app_icon_path(app_id, &icon_path) == APP_MANAGER_ERROR_NONE)
+	{
+		free(icon_path);
+	}
+}
+
+static void bench_get_app_version(int index)
+{
+	char app_id[BENCH_APP_ID_MAX];
+	char *version;
+
+	bench_installed_app_id(index, app_id, sizeof(app_id));
+
+	if (app_manager_get_app_version(app_id, &version) == APP_MANAGER_ERROR_NONE)
+	{
+		free(version);
+	}
+}
+
+static const bench_case_s bench_cases[] = {
+	{ "app_manager_get_app_context", false, bench_get_app_context },
+	{ "app_manager_foreach_app_context", true, bench_foreach_app_context },
+	{ "app_manager_foreach_app_info", true, bench_foreach_app_info },
+	{ "app_manager_foreach_app_info+app_info_get_*", true, bench_foreach_app_info_get },
+	{ "app_manager_foreach_app_info+app_info_get_*_peek", true, bench_foreach_app_info_peek },
+	{ "app_manager_get_app_id", false, bench_get_app_id },
+	{ "app_manager_is_running", false, bench_is_running },
+	{ "app_context_is_terminated", false, bench_app_context_is_terminated },
+	{ "app_manager_get_app_info+app_info_get_name_peek", false, bench_get_app_info },
+	{ "app_manager_get_app_name", false, bench_get_app_name },
+	{ "app_manager_get_app_icon_path", false, bench_get_app_icon_path },
+	{ "app_manager_get_app_version", false, bench_get_app_version },
+};
+
+static void bench_app_context_event_cb(app_context_h app_context, app_context_event_e event, void *user_data)
+{
+}
+
+static int bench_compare_samples(const void *lhs, const void *rhs)
+{
+	unsigned long long a = *(const unsigned long long *)lhs;
+	unsigned long long b = *(const unsigned long long *)rhs;
+
+	return (a > b) - (a < b);
+}
+
+static unsigned long long bench_percentile(bench_result_s *result, int percentile)
+{
+	int index = (int)((long long)(result->count - 1) * percentile / 100);
+
+	return result->samples[index];
+}
+
+static void bench_run_case(const bench_case_s *bench_case, bench_result_s *result)
+{
+	unsigned long long start;
+	unsigned long allocs_before;
+	int i;
+
+	// one untimed call so that lazily started listeners and caches are not charged to the first sample
+	bench_case->run(0);
+
+	for (i = 0; i < result->count; i++)
+	{
+		allocs_before = alloc_count;
+		start = bench_now();
+
+		bench_case->run(i);
+
+		result->samples[i] = bench_now() - start;
+		result->allocs += alloc_count - allocs_before;
+	}
+
+	qsort(result->samples, result->count, sizeof(result->samples[0]), bench_compare_samples);
+}
+
+static void bench_print_result(FILE *output, const char *name, const char *mode, bench_result_s *result, bool last)
+{
+	unsigned long long total = 0;
+	int i;
+
+	for (i = 0; i < result->count; i++)
+	{
+		total += result->samples[i];
+	}
+
+	fprintf(output,
+		"    {\"name\": \"%s\", \"mode\": \"%s\", \"calls\": %d, "
+		"\"mean_ns\": %llu, \"p50_ns\": %llu, \"p90_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu, "
+		"\"allocs_per_call\": %.2f}%s\n",
+		name, mode, result->count,
+		total / result->count,
+		bench_percentile(result, 50),
+		bench_percentile(result, 90),
+		bench_percentile(result, 99),
+		result->samples[result->count - 1],
+		(double)result->allocs / result->count,
+		last ? "" : ",");
+}
+
+static void bench_print_pool_stats(FILE *output, const char *name, app_manager_handle_type_e type, bool last)
+{
+	app_manager_handle_pool_stats_s stats;
+
+	app_manager_get_handle_pool_stats(type, &stats);
+
+	fprintf(output,
+		"    \"%s\": {\"slabs\": %u, \"capacity\": %u, \"in_use\": %u, \"peak\": %u, \"takes\": %u}%s\n",
+		name, stats.slabs, stats.capacity, stats.in_use, stats.peak, stats.takes, last ? "" : ",");
+}
+
+static void bench_usage(const char *program)
+{
+	fprintf(stderr,
+		"usage: %s [--running N] [--installed N] [--iterations N] [--foreach-iterations N] "
+		"[--ipc-latency USEC] [--index FILE] [--output FILE]\n",
+		program);
+}
+
+static bool bench_parse_options(int argc, char **argv)
+{
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+
+		if (value == NULL)
+		{
+			return false;
+		}
+
+		if (strcmp(argv[i], "--running") == 0)
+		{
+			options.running = atoi(value);
+		}
+		else if (strcmp(argv[i], "--installed") == 0)
+		{
+			options.installed = atoi(value);
+		}
+		else if (strcmp(argv[i], "--iterations") == 0)
+		{
+			options.iterations = atoi(value);
+		}
+		else if (strcmp(argv[i], "--foreach-iterations") == 0)
+		{
+			options.foreach_iterations = atoi(value);
+		}
+		else if (strcmp(argv[i], "--ipc-latency") == 0)
+		{
+			options.ipc_latency = atoi(value);
+		}
+		else if (strcmp(argv[i], "--index") == 0)
+		{
+			options.index = value;
+		}
+		else if (strcmp(argv[i], "--output") == 0)
+		{
+			options.output = value;
+		}
+		else
+		{
+			return false;
+		}
+
+		i++;
+	}
+
+	return options.running > 0 && options.installed >= options.running
+			&& options.iterations > 0 && options.foreach_iterations > 0;
+}
+
+int main(int argc, char **argv)
+{
+	static const char *modes[] = { "cold", "warm", "indexed" };
+	int case_count = sizeof(bench_cases) / sizeof(bench_cases[0]);
+	int mode_count;
+	bench_result_s result;
+	FILE *output = stdout;
+	int mode;
+	int i;
+
+	if (bench_parse_options(argc, argv) == false)
+	{
+		bench_usage(argv[0]);
+		return 1;
+	}
+
+	if (options.output != NULL)
+	{
+		output = fopen(options.output, "w");
+
+		if (output == NULL)
+		{
+			perror(options.output);
+			return 1;
+		}
+	}
+
+	if (fake_backend_populate(options.installed, options.running) != 0)
+	{
+		fprintf(stderr, "failed to populate the fake backend\n");
+		return 1;
+	}
+
+	fake_backend_set_ipc_latency(options.ipc_latency);
+
+	app_manager_get_app_context_by_pid(1000, &bench_app_context);
+
+	fprintf(output, "{\n  \"running\": %d,\n  \"installed\": %d,\n  \"ipc_latency_usec\": %u,\n  \"results\": [\n",
+		options.running, options.installed, options.ipc_latency);
+
+	// "indexed" is "warm" with the application information served from the index file, which is rebuilt first
+	if (options.index != NULL)
+	{
+		unlink(options.index);
+		mode_count = 3;
+	}
+	else
+	{
+		mode_count = 2;
+	}
+
+	// "cold" polls AUL on every call, "warm" has an app context event callback keeping the registry up to date
+	for (mode = 0; mode < mode_count; mode++)
+	{
+		if (mode == 1)
+		{
+			app_manager_set_app_context_event_cb(bench_app_context_event_cb, NULL);
+		}
+		else if (mode == 2)
+		{
+			app_manager_set_app_info_index_path(options.index);
+		}
+
+		for (i = 0; i < case_count; i++)
+		{
+			result.count = bench_cases[i].foreach ? options.foreach_iterations : options.iterations;
+			result.samples = calloc(result.count, sizeof(result.samples[0]));
+			result.allocs = 0;
+
+			bench_run_case(&bench_cases[i], &result);
+			bench_print_result(output, bench_cases[i].name, modes[mode], &result, mode == mode_count - 1 && i == case_count - 1);
+
+			free(result.samples);
+		}
+	}
+
+	fprintf(output, "  ],\n  \"handle_pools\": {\n");
+	bench_print_pool_stats(output, "app_context", APP_MANAGER_HANDLE_TYPE_APP_CONTEXT, false);
+	bench_print_pool_stats(output, "app_info", APP_MANAGER_HANDLE_TYPE_APP_INFO, true);
+	fprintf(output, "  }\n}\n");
+
+	app_manager_unset_app_context_event_cb();
+	app_manager_set_app_info_index_path(NULL);
+	app_context_destroy(bench_app_context);
+
+	if (output != stdout)
+	{
+		fclose(output);
+	}
+
+	return 0;
+}
@@ -0,0 +1,557 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <app_manager.h>
+
+#include <fake_backend.h>
+
+#define STRESS_APP_ID_MAX 128
+#define STRESS_PID_BASE 100000
+
+typedef struct {
+	int running;
+	int installed;
+	int emitters;
+	int bursts;
+	int burst_size;
+	int rate;
+	int readers;
+	int sample_interval;
+	unsigned int callback_cost;
+	unsigned int ipc_latency;
+	bool async;
+	const char *output;
+} stress_options_s;
+
+typedef struct {
+	volatile unsigned long long launch_emitted;
+	volatile unsigned long long dead_emitted;
+	volatile int launch_delivered;
+	volatile int dead_delivered;
+} stress_pid_state_s;
+
+typedef struct {
+	unsigned long long t_ms;
+	int size;
+} stress_sample_s;
+
+static stress_options_s options = {
+	.running = 50,
+	.installed = 500,
+	.emitters = 2,
+	.bursts = 100,
+	.burst_size = 50,
+	.rate = 5000,
+	.readers = 2,
+	.sample_interval = 10,
+	.callback_cost = 0,
+	.ipc_latency = 0,
+	.async = false,
+	.output = NULL,
+};
+
+static stress_pid_state_s *pid_states = NULL;
+static int pid_count = 0;
+
+static unsigned long long *latencies = NULL;
+static volatile int latency_count = 0;
+
+static volatile unsigned long launch_emitted = 0;
+static volatile unsigned long dead_emitted = 0;
+static volatile unsigned long launch_delivered = 0;
+static volatile unsigned long dead_delivered = 0;
+static volatile unsigned long misordered = 0;
+static volatile unsigned long unexpected = 0;
+static volatile unsigned long lookups = 0;
+
+static stress_sample_s *samples = NULL;
+static int sample_count = 0;
+static int sample_max = 0;
+
+static volatile int stopping = 0;
+static unsigned long long start_time = 0;
+
+static unsigned long long stress_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (unsigned long long)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void stress_sleep_until(unsigned long long deadline)
+{
+	struct timespec request;
+	unsigned long long now = stress_now();
+
+	if (deadline <= now)
+	{
+		return;
+	}
+
+	request.tv_sec = (deadline - now) / 1000000000ULL;
+	request.tv_nsec = (deadline - now) % 1000000000ULL;
+
+	nanosleep(&request, NULL);
+}
+
+static void stress_spin(unsigned int usec)
+{
+	unsigned long long deadline = stress_now() + usec * 1000ULL;
+
+	while (stress_now() < deadline)
+	{
+	}
+}
+
+static stress_pid_state_s *stress_get_pid_state(pid_t pid)
+{
+	if (pid < STRESS_PID_BASE || pid >= STRESS_PID_BASE + pid_count)
+	{
+		return NULL;
+	}
+
+	return &pid_states[pid - STRESS_PID_BASE];
+}
+
+static void stress_record_latency(unsigned long long emitted)
+{
+	int index = __sync_fetch_and_add(&latency_count, 1);
+
+	latencies[index] = stress_now() - emitted;
+}
+
+static void stress_app_context_event_cb(app_context_h app_context, app_context_event_e event, void *user_data)
+{
+	stress_pid_state_s *state;
+	pid_t pid = 0;
+
+	app_context_get_pid(app_context, &pid);
+
+	state = stress_get_pid_state(pid);
+
+	if (state == NULL)
+	{
+		__sync_fetch_and_add(&unexpected, 1);
+		return;
+	}
+
+	if (event == APP_CONTEXT_EVENT_LAUNCHED)
+	{
+		if (state->launch_delivered || state->dead_delivered)
+		{
+			__sync_fetch_and_add(&misordered, 1);
+		}
+
+		state->launch_delivered = 1;
+		__sync_fetch_and_add(&launch_delivered, 1);
+		stress_record_latency(state->launch_emitted);
+	}
+	else
+	{
+		if (!state->launch_delivered || state->dead_delivered)
+		{
+			__sync_fetch_and_add(&misordered, 1);
+		}
+
+		state->dead_delivered = 1;
+		__sync_fetch_and_add(&dead_delivered, 1);
+		stress_record_latency(state->dead_emitted);
+	}
+
+	// emulates a subscriber doing real work in the callback
+	stress_spin(options.callback_cost);
+}
+
+static void stress_launch(pid_t pid, const char *app_id)
+{
+	stress_get_pid_state(pid)->launch_emitted = stress_now();
+	__sync_fetch_and_add(&launch_emitted, 1);
+	fake_aul_launch_app(pid, app_id);
+}
+
+static void stress_terminate(pid_t pid)
+{
+	stress_get_pid_state(pid)->dead_emitted = stress_now();
+	__sync_fetch_and_add(&dead_emitted, 1);
+	fake_aul_terminate_app(pid);
+}
+
+// each emitter owns a disjoint pid range, launches one burst and kills the previous one
+static void *stress_emitter(void *data)
+{
+	int emitter = (int)(long)data;
+	int per_burst = options.burst_size / options.emitters;
+	unsigned long long period = 1000000000ULL * options.burst_size / options.rate;
+	char app_id[STRESS_APP_ID_MAX];
+	pid_t base;
+	int burst;
+	int i;
+
+	for (burst = 0; burst < options.bursts; burst++)
+	{
+		stress_sleep_until(start_time + period * burst);
+
+		base = STRESS_PID_BASE + (burst * options.emitters + emitter) * per_burst;
+
+		for (i = 0; i < per_burst; i++)
+		{
+			fake_backend_app_id(options.running + (base + i) % (options.installed - options.running), app_id, sizeof(app_id));
+			stress_launch(base + i, app_id);
+		}
+
+		if (burst > 0)
+		{
+			base -= options.emitters * per_burst;
+
+			for (i = 0; i < per_burst; i++)
+			{
+				stress_terminate(base + i);
+			}
+		}
+	}
+
+	base = STRESS_PID_BASE + ((options.bursts - 1) * options.emitters + emitter) * per_burst;
+
+	for (i = 0; i < per_burst; i++)
+	{
+		stress_terminate(base + i);
+	}
+
+	return NULL;
+}
+
+static void *stress_reader(void *data)
+{
+	unsigned int seed = (unsigned int)(long)data;
+	char app_id[STRESS_APP_ID_MAX];
+	app_context_h app_context;
+
+	while (!stopping)
+	{
+		fake_backend_app_id(rand_r(&seed) % options.installed, app_id, sizeof(app_id));
+
+		if (app_manager_get_app_context(app_id, &app_context) == APP_MANAGER_ERROR_NONE)
+		{
+			app_context_destroy(app_context);
+		}
+
+		__sync_fetch_and_add(&lookups, 1);
+	}
+
+	return NULL;
+}
+
+static int stress_get_table_size(void)
+{
+	app_context_snapshot_h snapshot;
+	const app_context_record_s *records;
+	int count = -1;
+
+	if (app_manager_get_running_app_snapshot(&snapshot) == APP_MANAGER_ERROR_NONE)
+	{
+		app_context_snapshot_get_records(snapshot, &records, &count);
+		app_context_snapshot_destroy(snapshot);
+	}
+
+	return count;
+}
+
+static void *stress_sampler(void *data)
+{
+	unsigned long long next = start_time;
+
+	while (!stopping && sample_count < sample_max)
+	{
+		samples[sample_count].t_ms = (stress_now() - start_time) / 1000000ULL;
+		samples[sample_count].size = stress_get_table_size();
+		sample_count++;
+
+		next += options.sample_interval * 1000000ULL;
+		stress_sleep_until(next);
+	}
+
+	return NULL;
+}
+
+static int stress_compare_latencies(const void *lhs, const void *rhs)
+{
+	unsigned long long a = *(const unsigned long long *)lhs;
+	unsigned long long b = *(const unsigned long long *)rhs;
+
+	return (a > b) - (a < b);
+}
+
+static unsigned long long stress_percentile(int percentile)
+{
+	if (latency_count == 0)
+	{
+		return 0;
+	}
+
+	return latencies[(int)((long long)(latency_count - 1) * percentile / 100)];
+}
+
+// in the asynchronous mode the dispatcher may still be delivering when the emitters are done
+static void stress_wait_for_dispatcher(void)
+{
+	unsigned int dispatched;
+	unsigned int coalesced;
+	unsigned int dropped;
+	int retry;
+
+	for (retry = 0; retry < 1000; retry++)
+	{
+		app_manager_get_app_context_event_stats(&dispatched, &coalesced, &dropped);
+
+		if (launch_delivered + dead_delivered + coalesced + dropped >= launch_emitted + dead_emitted)
+		{
+			return;
+		}
+
+		stress_sleep_until(stress_now() + 10000000ULL);
+	}
+}
+
+static void stress_print_report(FILE *output, unsigned long long elapsed)
+{
+	unsigned int dispatched;
+	unsigned int coalesced;
+	unsigned int dropped;
+	int i;
+
+	app_manager_get_app_context_event_stats(&dispatched, &coalesced, &dropped);
+
+	qsort(latencies, latency_count, sizeof(latencies[0]), stress_compare_latencies);
+
+	fprintf(output, "{\n");
+	fprintf(output, "  \"running\": %d,\n  \"installed\": %d,\n  \"emitters\": %d,\n  \"bursts\": %d,\n"
+		"  \"burst_size\": %d,\n  \"rate\": %d,\n  \"readers\": %d,\n  \"callback_cost_usec\": %u,\n"
+		"  \"ipc_latency_usec\": %u,\n  \"dispatch\": \"%s\",\n",
+		options.running, options.installed, options.emitters, options.bursts,
+		options.burst_size, options.rate, options.readers, options.callback_cost, options.ipc_latency,
+		options.async ? "async" : "sync");
+	fprintf(output, "  \"elapsed_ms\": %llu,\n  \"events_per_sec\": %.0f,\n",
+		elapsed / 1000000ULL, (launch_emitted + dead_emitted) * 1e9 / elapsed);
+	fprintf(output, "  \"launch_emitted\": %lu,\n  \"launch_delivered\": %lu,\n"
+		"  \"dead_emitted\": %lu,\n  \"dead_delivered\": %lu,\n",
+		launch_emitted, launch_delivered, dead_emitted, dead_delivered);
+	fprintf(output, "  \"dropped\": %lu,\n  \"misordered\": %lu,\n  \"unexpected\": %lu,\n  \"lookups\": %lu,\n",
+		(launch_emitted + dead_emitted) - (launch_delivered + dead_delivered) - coalesced, misordered, unexpected, lookups);
+	fprintf(output, "  \"queue\": {\"dispatched\": %u, \"coalesced\": %u, \"dropped\": %u},\n",
+		dispatched, coalesced, dropped);
+	fprintf(output, "  \"latency_ns\": {\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu},\n",
+		stress_percentile(50), stress_percentile(90), stress_percentile(99), stress_percentile(100));
+	fprintf(output, "  \"final_table_size\": %d,\n  \"final_running\": %d,\n",
+		stress_get_table_size(), fake_aul_get_running_app_count());
+	fprintf(output, "  \"table_size\": [");
+
+	for (i = 0; i < sample_count; i++)
+	{
+		fprintf(output, "%s[%llu, %d]", i == 0 ? "" : ", ", samples[i].t_ms, samples[i].size);
+	}
+
+	fprintf(output, "]\n}\n");
+}
+
+static void stress_usage(const char *program)
+{
+	fprintf(stderr,
+		"usage: %s [--running N] [--installed N] [--emitters N] [--bursts N] [--burst-size N] "
+		"[--rate EVENTS_PER_SEC] [--readers N] [--sample-interval MSEC] [--callback-cost USEC] "
+		"[--ipc-latency USEC] [--dispatch sync|async] [--output FILE]\n",
+		program);
+}
+
+static bool stress_parse_options(int argc, char **argv)
+{
+	int i;
+
+	for (i = 1; i + 1 < argc; i += 2)
+	{
+		const char *value = argv[i + 1];
+
+		if (strcmp(argv[i], "--running") == 0)
+		{
+			options.running = atoi(value);
+		}
+		else if (strcmp(argv[i], "--installed") == 0)
+		{
+			options.installed = atoi(value);
+		}
+		else if (strcmp(argv[i], "--emitters") == 0)
+		{
+			options.emitters = atoi(value);
+		}
+		else if (strcmp(argv[i], "--bursts") == 0)
+		{
+			options.bursts = atoi(value);
+		}
+		else if (strcmp(argv[i], "--burst-size") == 0)
+		{
+			options.burst_size = atoi(value);
+		}
+		else if (strcmp(argv[i], "--rate") == 0)
+		{
+			options.rate = atoi(value);
+		}
+		else if (strcmp(argv[i], "--readers") == 0)
+		{
+			options.readers = atoi(value);
+		}
+		else if (strcmp(argv[i], "--sample-interval") == 0)
+		{
+			options.sample_interval = atoi(value);
+		}
+		else if (strcmp(argv[i], "--callback-cost") == 0)
+		{
+			options.callback_cost = atoi(value);
+		}
+		else if (strcmp(argv[i], "--ipc-latency") == 0)
+		{
+			options.ipc_latency = atoi(value);
+		}
+		else if (strcmp(argv[i], "--dispatch") == 0 && (strcmp(value, "sync") == 0 || strcmp(value, "async") == 0))
+		{
+			options.async = strcmp(value, "async") == 0;
+		}
+		else if (strcmp(argv[i], "--output") == 0)
+		{
+			options.output = value;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return i == argc && options.running >= 0 && options.installed > options.running
+			&& options.emitters > 0 && options.bursts > 0 && options.burst_size >= options.emitters
+			&& options.rate > 0 && options.readers >= 0 && options.sample_interval > 0;
+}
+
+int main(int argc, char **argv)
+{
+	pthread_t *emitters;
+	pthread_t *readers;
+	pthread_t sampler;
+	unsigned long long elapsed;
+	FILE *output = stdout;
+	int i;
+
+	if (stress_parse_options(argc, argv) == false)
+	{
+		stress_usage(argv[0]);
+		return 1;
+	}
+
+	if (options.output != NULL)
+	{
+		output = fopen(options.output, "w");
+
+		if (output == NULL)
+		{
+			perror(options.output);
+			return 1;
+		}
+	}
+
+	if (fake_backend_populate(options.installed, options.running) != 0)
+	{
+		fprintf(stderr, "failed to populate the fake backend\n");
+		return 1;
+	}
+
+	fake_backend_set_ipc_latency(options.ipc_latency);
+
+	pid_count = options.bursts * (options.burst_size / options.emitters) * options.emitters;
+	pid_states = calloc(pid_count, sizeof(pid_states[0]));
+	latencies = calloc(pid_count * 2, sizeof(latencies[0]));
+	sample_max = 1 + (int)(2000ULL * options.bursts * options.burst_size / options.rate / options.sample_interval) + 1000;
+	samples = calloc(sample_max, sizeof(samples[0]));
+	emitters = calloc(options.emitters, sizeof(emitters[0]));
+	readers = calloc(options.readers, sizeof(readers[0]));
+
+	if (pid_states == NULL || latencies == NULL || samples == NULL || emitters == NULL || (options.readers > 0 && readers == NULL))
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	if (options.async == true && app_manager_set_app_context_event_dispatch_mode(APP_MANAGER_EVENT_DISPATCH_ASYNC) != APP_MANAGER_ERROR_NONE)
+	{
+		fprintf(stderr, "failed to start the event dispatcher\n");
+		return 1;
+	}
+
+	app_manager_set_app_context_event_cb(stress_app_context_event_cb, NULL);
+
+	start_time = stress_now();
+
+	pthread_create(&sampler, NULL, stress_sampler, NULL);
+
+	for (i = 0; i < options.readers; i++)
+	{
+		pthread_create(&readers[i], NULL, stress_reader, (void *)(long)i);
+	}
+
+	for (i = 0; i < options.emitters; i++)
+	{
+		pthread_create(&emitters[i], NULL, stress_emitter, (void *)(long)i);
+	}
+
+	for (i = 0; i < options.emitters; i++)
+	{
+		pthread_join(emitters[i], NULL);
+	}
+
+	stress_wait_for_dispatcher();
+
+	elapsed = stress_now() - start_time;
+	stopping = 1;
+
+	for (i = 0; i < options.readers; i++)
+	{
+		pthread_join(readers[i], NULL);
+	}
+
+	pthread_join(sampler, NULL);
+
+	stress_print_report(output, elapsed);
+
+	app_manager_unset_app_context_event_cb();
+
+	if (output != stdout)
+	{
+		fclose(output);
+	}
+
+	free(readers);
+	free(emitters);
+	free(samples);
+	free(latencies);
+	free(pid_states);
+
+	return 0;
+}
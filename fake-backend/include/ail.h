@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#ifndef __FAKE_AIL_H__
+#define __FAKE_AIL_H__
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+	AIL_ERROR_FAIL = -1,
+	AIL_ERROR_DB_FAILED = -2,
+	AIL_ERROR_OUT_OF_MEMORY = -3,
+	AIL_ERROR_INVALID_PARAMETER = -4,
+	AIL_ERROR_OK = 0,
+	AIL_ERROR_NO_DATA = 1,
+} ail_error_e;
+
+typedef enum {
+	AIL_CB_RET_CONTINUE = 0,
+	AIL_CB_RET_CANCEL,
+} ail_cb_ret_e;
+
+#define AIL_PROP_PACKAGE_STR "AIL_PROP_PACKAGE_STR"
+#define AIL_PROP_EXEC_STR "AIL_PROP_EXEC_STR"
+#define AIL_PROP_NAME_STR "AIL_PROP_NAME_STR"
+#define AIL_PROP_TYPE_STR "AIL_PROP_TYPE_STR"
+#define AIL_PROP_ICON_STR "AIL_PROP_ICON_STR"
+#define AIL_PROP_CATEGORIES_STR "AIL_PROP_CATEGORIES_STR"
+#define AIL_PROP_VERSION_STR "AIL_PROP_VERSION_STR"
+#define AIL_PROP_X_SLP_PACKAGETYPE_STR "AIL_PROP_X_SLP_PACKAGETYPE_STR"
+#define AIL_PROP_NODISPLAY_BOOL "AIL_PROP_NODISPLAY_BOOL"
+#define AIL_PROP_X_SLP_TASKMANAGE_BOOL "AIL_PROP_X_SLP_TASKMANAGE_BOOL"
+#define AIL_PROP_X_SLP_MULTIPLE_BOOL "AIL_PROP_X_SLP_MULTIPLE_BOOL"
+#define AIL_PROP_X_SLP_REMOVABLE_BOOL "AIL_PROP_X_SLP_REMOVABLE_BOOL"
+#define AIL_PROP_X_SLP_INSTALLEDTIME_INT "AIL_PROP_X_SLP_INSTALLEDTIME_INT"
+
+typedef struct ail_appinfo *ail_appinfo_h;
+
+typedef struct ail_filter *ail_filter_h;
+
+typedef ail_cb_ret_e (*ail_list_appinfo_cb) (const ail_appinfo_h appinfo_h, void *user_data);
+
+ail_error_e ail_package_get_appinfo(const char *package, ail_appinfo_h *handle);
+
+ail_error_e ail_package_destroy_appinfo(ail_appinfo_h handle);
+
+ail_error_e ail_appinfo_get_str(const ail_appinfo_h handle, const char *property, char **str);
+
+ail_error_e ail_appinfo_get_bool(const ail_appinfo_h handle, const char *property, bool *value);
+
+ail_error_e ail_appinfo_get_int(const ail_appinfo_h handle, const char *property, int *value);
+
+ail_error_e ail_filter_new(ail_filter_h *filter);
+
+ail_error_e ail_filter_destroy(ail_filter_h filter);
+
+ail_error_e ail_filter_add_bool(ail_filter_h filter, const char *property, bool value);
+
+ail_error_e ail_filter_add_int(ail_filter_h filter, const char *property, int value);
+
+ail_error_e ail_filter_add_str(ail_filter_h filter, const char *property, const char *value);
+
+ail_error_e ail_filter_count_appinfo(ail_filter_h filter, int *count);
+
+ail_error_e ail_filter_list_appinfo_foreach(ail_filter_h filter, ail_list_appinfo_cb appinfo_func, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAKE_AIL_H__ */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#ifndef __FAKE_AUL_H__
+#define __FAKE_AUL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum _aul_return_val {
+	AUL_R_EHIDDENFORGUEST = -11,
+	AUL_R_ENOLAUNCHPAD = -10,
+	AUL_R_ETERMINATING = -9,
+	AUL_R_EILLACC = -8,
+	AUL_R_LOCAL = -7,
+	AUL_R_ETIMEOUT = -6,
+	AUL_R_ECOMM = -5,
+	AUL_R_ENOAPP = -4,
+	AUL_R_EINVAL = -3,
+	AUL_R_ERROR = -1,
+	AUL_R_OK = 0
+} aul_return_val;
+
+typedef struct _aul_app_info {
+	int pid;
+	char *pkg_name;
+	char *app_path;
+} aul_app_info;
+
+typedef int (*aul_app_info_iter_fn)(const aul_app_info *ainfo, void *data);
+
+int aul_app_get_running_app_info(aul_app_info_iter_fn iter_fn, void *user_param);
+
+int aul_app_is_running(const char *pkgname);
+
+int aul_app_get_pkgname_bypid(int pid, char *pkgname, int len);
+
+int aul_listen_app_launch_signal(int (*func) (int, void *), void *data);
+
+int aul_listen_app_dead_signal(int (*func) (int, void *), void *data);
+
+int aul_resume_app(const char *pkgname);
+
+int aul_terminate_pid(int pid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAKE_AUL_H__ */
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#ifndef __FAKE_DLOG_H__
+#define __FAKE_DLOG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+	DLOG_DEBUG = 3,
+	DLOG_INFO,
+	DLOG_WARN,
+	DLOG_ERROR,
+} log_priority;
+
+/* Writes to stderr. The threshold is taken from FAKE_DLOG_LEVEL (D, I, W, E or S for silent). */
+int fake_dlog_print(log_priority prio, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#define LOGD(fmt, arg...) fake_dlog_print(DLOG_DEBUG, LOG_TAG, fmt, ##arg)
+#define LOGI(fmt, arg...) fake_dlog_print(DLOG_INFO, LOG_TAG, fmt, ##arg)
+#define LOGW(fmt, arg...) fake_dlog_print(DLOG_WARN, LOG_TAG, fmt, ##arg)
+#define LOGE(fmt, arg...) fake_dlog_print(DLOG_ERROR, LOG_TAG, fmt, ##arg)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAKE_DLOG_H__ */
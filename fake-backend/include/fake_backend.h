@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+#ifndef __FAKE_BACKEND_H__
+#define __FAKE_BACKEND_H__
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sets the latency each emulated AUL/AIL round-trip spins for, in microseconds.
+ */
+void fake_backend_set_ipc_latency(unsigned int usec);
+
+/**
+ * @brief Gets the number of emulated AUL round-trips since the last reset.
+ */
+unsigned long fake_backend_get_ipc_count(void);
+
+/**
+ * @brief Gets the number of emulated AIL database queries since the last reset.
+ */
+unsigned long fake_backend_get_query_count(void);
+
+/**
+ * @brief Resets the IPC and query counters.
+ */
+void fake_backend_reset_counters(void);
+
+/**
+ * @brief Installs @a installed applications and starts the first @a running of them.
+ * @remarks The application IDs are "org.tizen.fake00000", "org.tizen.fake00001", ... and the pids start from 1000.
+ */
+int fake_backend_populate(int installed, int running);
+
+/**
+ * @brief Gets the application ID fake_backend_populate() used for @a index.
+ */
+void fake_backend_app_id(int index, char *buffer, int size);
+
+/**
+ * @brief Adds a process to the running-app table without emitting the launch signal.
+ */
+int fake_aul_add_running_app(int pid, const char *app_id);
+
+/**
+ * @brief Adds a process to the running-app table and emits the launch signal.
+ */
+int fake_aul_launch_app(int pid, const char *app_id);
+
+/**
+ * @brief Removes a process from the running-app table and emits the dead signal.
+ */
+int fake_aul_terminate_app(int pid);
+
+/**
+ * @brief Emits the launch signal for @a pid without touching the running-app table.
+ */
+void fake_aul_emit_launch_signal(int pid);
+
+/**
+ * @brief Emits the dead signal for @a pid without touching the running-app table.
+ */
+void fake_aul_emit_dead_signal(int pid);
+
+/**
+ * @brief Removes every process from the running-app table.
+ */
+void fake_aul_clear_running_apps(void);
+
+/**
+ * @brief Gets the number of processes in the running-app table.
+ */
+int fake_aul_get_running_app_count(void);
+
+/**
+ * @brief Inserts or replaces a row in the fake application database.
+ */
+int fake_ail_install_app(const char *app_id, const char *name, const char *icon, const char *version,
+		const char *type, bool nodisplay, bool taskmanage);
+
+/**
+ * @brief Removes a row from the fake application database.
+ */
+int fake_ail_uninstall_app(const char *app_id);
+
+/**
+ * @brief Removes every row from the fake application database.
+ */
+void fake_ail_clear_apps(void);
+
+/**
+ * @brief Gets the number of package manager clients listening for status messages.
+ */
+int fake_pkgmgr_get_listener_count(void);
+
+/**
+ * @brief Delivers one status message to every listening package manager client.
+ */
+void fake_pkgmgr_emit(int req_id, const char *pkg_type, const char *package, const char *key, const char *val);
+
+/**
+ * @brief Delivers the start and the successful end message of one operation ("install", "uninstall" or "update").
+ */
+void fake_pkgmgr_emit_operation(int req_id, const char *operation, const char *package);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAKE_BACKEND_H__ */
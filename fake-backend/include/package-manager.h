@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#ifndef __FAKE_PACKAGE_MANAGER_H__
+#define __FAKE_PACKAGE_MANAGER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PKGMGR_R_OK 0
+#define PKGMGR_R_ERROR -1
+#define PKGMGR_R_EINVAL -2
+
+typedef void pkgmgr_client;
+
+typedef enum {
+	PC_REQUEST = 0,
+	PC_LISTENING,
+	PC_BROADCAST,
+} client_type;
+
+typedef int (*pkgmgr_handler)(int req_id, const char *pkg_type,
+				const char *pkgid, const char *key,
+				const char *val, const void *pmsg, void *data);
+
+pkgmgr_client *pkgmgr_client_new(client_type ctype);
+
+int pkgmgr_client_free(pkgmgr_client *pc);
+
+int pkgmgr_client_listen_status(pkgmgr_client *pc, pkgmgr_handler event_cb, void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAKE_PACKAGE_MANAGER_H__ */
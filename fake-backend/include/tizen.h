@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#ifndef __FAKE_TIZEN_H__
+#define __FAKE_TIZEN_H__
+
+#include <errno.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TIZEN_ERROR_APPLICATION_CLASS -0x00400000
+
+typedef enum
+{
+	TIZEN_ERROR_NONE = 0,
+	TIZEN_ERROR_OUT_OF_MEMORY = -ENOMEM,
+	TIZEN_ERROR_INVALID_PARAMETER = -EINVAL,
+	TIZEN_ERROR_IO_ERROR = -EIO,
+} tizen_error_e;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAKE_TIZEN_H__ */
@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <sqlite3.h>
+
+#include <ail.h>
+#include <dlog.h>
+
+#include <fake_backend.h>
+#include "fake_backend_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "FAKE_AIL"
+
+typedef enum {
+	FAKE_AIL_TYPE_STR,
+	FAKE_AIL_TYPE_BOOL,
+	FAKE_AIL_TYPE_INT,
+} fake_ail_type_e;
+
+typedef struct {
+	const char *property;
+	const char *column;
+	fake_ail_type_e type;
+} fake_ail_property_s;
+
+static const fake_ail_property_s fake_ail_properties[] = {
+	{ AIL_PROP_PACKAGE_STR, "package", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_EXEC_STR, "exec", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_NAME_STR, "name", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_TYPE_STR, "type", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_ICON_STR, "icon", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_CATEGORIES_STR, "categories", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_VERSION_STR, "version", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_X_SLP_PACKAGETYPE_STR, "x_slp_packagetype", FAKE_AIL_TYPE_STR },
+	{ AIL_PROP_NODISPLAY_BOOL, "nodisplay", FAKE_AIL_TYPE_BOOL },
+	{ AIL_PROP_X_SLP_TASKMANAGE_BOOL, "x_slp_taskmanage", FAKE_AIL_TYPE_BOOL },
+	{ AIL_PROP_X_SLP_MULTIPLE_BOOL, "x_slp_multiple", FAKE_AIL_TYPE_BOOL },
+	{ AIL_PROP_X_SLP_REMOVABLE_BOOL, "x_slp_removable", FAKE_AIL_TYPE_BOOL },
+	{ AIL_PROP_X_SLP_INSTALLEDTIME_INT, "x_slp_installedtime", FAKE_AIL_TYPE_INT },
+};
+
+#define FAKE_AIL_PROPERTY_COUNT ((int)(sizeof(fake_ail_properties) / sizeof(fake_ail_properties[0])))
+
+#define FAKE_AIL_COLUMNS \
+	"package, exec, name, type, icon, categories, version, x_slp_packagetype, " \
+	"nodisplay, x_slp_taskmanage, x_slp_multiple, x_slp_removable, x_slp_installedtime"
+
+struct ail_appinfo {
+	char *values[FAKE_AIL_PROPERTY_COUNT];
+};
+
+typedef struct _fake_ail_condition_ {
+	int property;
+	char *value;
+	struct _fake_ail_condition_ *next;
+} fake_ail_condition_s;
+
+struct ail_filter {
+	fake_ail_condition_s *conditions;
+};
+
+static pthread_mutex_t db_mutex;
+static pthread_once_t db_mutex_once = PTHREAD_ONCE_INIT;
+static sqlite3 *db = NULL;
+
+static void fake_ail_init_mutex(void)
+{
+	pthread_mutexattr_t attr;
+
+	/* the list callbacks are allowed to query the database again */
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&db_mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+static void fake_ail_lock(void)
+{
+	pthread_once(&db_mutex_once, fake_ail_init_mutex);
+	pthread_mutex_lock(&db_mutex);
+}
+
+static void fake_ail_unlock(void)
+{
+	pthread_mutex_unlock(&db_mutex);
+}
+
+static sqlite3 *fake_ail_get_db_locked(void)
+{
+	const char *path;
+
+	if (db != NULL)
+	{
+		return db;
+	}
+
+	path = getenv("FAKE_AIL_DB");
+
+	if (sqlite3_open(path != NULL ? path : ":memory:", &db) != SQLITE_OK)
+	{
+		LOGE("[%s] failed to open the database", __FUNCTION__);
+		sqlite3_close(db);
+		db = NULL;
+		return NULL;
+	}
+
+	if (sqlite3_exec(db,
+			"CREATE TABLE IF NOT EXISTS app_info ("
+			"package TEXT PRIMARY KEY, exec TEXT, name TEXT, type TEXT, icon TEXT, categories TEXT, "
+			"version TEXT, x_slp_packagetype TEXT, nodisplay INTEGER DEFAULT 0, "
+			"x_slp_taskmanage INTEGER DEFAULT 1, x_slp_multiple INTEGER DEFAULT 0, "
+			"x_slp_removable INTEGER DEFAULT 1, x_slp_installedtime INTEGER DEFAULT 0)",
+			NULL, NULL, NULL) != SQLITE_OK)
+	{
+		LOGE("[%s] failed to create the table : %s", __FUNCTION__, sqlite3_errmsg(db));
+		sqlite3_close(db);
+		db = NULL;
+		return NULL;
+	}
+
+	return db;
+}
+
+static int fake_ail_find_property(const char *property, fake_ail_type_e type)
+{
+	int i;
+
+	if (property == NULL)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < FAKE_AIL_PROPERTY_COUNT; i++)
+	{
+		if (fake_ail_properties[i].type == type && !strcmp(fake_ail_properties[i].property, property))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static ail_appinfo_h fake_ail_appinfo_from_row(sqlite3_stmt *stmt)
+{
+	ail_appinfo_h appinfo;
+	int i;
+
+	appinfo = calloc(1, sizeof(struct ail_appinfo));
+
+	if (appinfo == NULL)
+	{
+		return NULL;
+	}
+
+	for (i = 0; i < FAKE_AIL_PROPERTY_COUNT; i++)
+	{
+		const unsigned char *text = sqlite3_column_text(stmt, i);
+
+		appinfo->values[i] = strdup(text != NULL ? (const char *)text : "");
+
+		if (appinfo->values[i] == NULL)
+		{
+			ail_package_destroy_appinfo(appinfo);
+			return NULL;
+		}
+	}
+
+	return appinfo;
+}
+
+ail_error_e ail_package_get_appinfo(const char *package, ail_appinfo_h *handle)
+{
+	sqlite3 *conn;
+	sqlite3_stmt *stmt;
+	ail_error_e retval;
+	int step;
+
+	if (package == NULL || handle == NULL)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	fake_backend_query();
+
+	fake_ail_lock();
+
+	conn = fake_ail_get_db_locked();
+
+	if (conn == NULL || sqlite3_prepare_v2(conn, "SELECT " FAKE_AIL_COLUMNS " FROM app_info WHERE package = ?", -1, &stmt, NULL) != SQLITE_OK)
+	{
+		fake_ail_unlock();
+		return AIL_ERROR_DB_FAILED;
+	}
+
+	sqlite3_bind_text(stmt, 1, package, -1, SQLITE_TRANSIENT);
+
+	step = sqlite3_step(stmt);
+
+	if (step == SQLITE_ROW)
+	{
+		*handle = fake_ail_appinfo_from_row(stmt);
+		retval = *handle != NULL ? AIL_ERROR_OK : AIL_ERROR_OUT_OF_MEMORY;
+	}
+	else if (step == SQLITE_DONE)
+	{
+		retval = AIL_ERROR_NO_DATA;
+	}
+	else
+	{
+		retval = AIL_ERROR_DB_FAILED;
+	}
+
+	sqlite3_finalize(stmt);
+
+	fake_ail_unlock();
+
+	return retval;
+}
+
+ail_error_e ail_package_destroy_appinfo(ail_appinfo_h handle)
+{
+	int i;
+
+	if (handle == NULL)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	for (i = 0; i < FAKE_AIL_PROPERTY_COUNT; i++)
+	{
+		free(handle->values[i]);
+	}
+
+	free(handle);
+
+	return AIL_ERROR_OK;
+}
+
+ail_error_e ail_appinfo_get_str(const ail_appinfo_h handle, const char *property, char **str)
+{
+	int index = fake_ail_find_property(property, FAKE_AIL_TYPE_STR);
+
+	if (handle == NULL || str == NULL || index < 0)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	*str = handle->values[index];
+
+	return AIL_ERROR_OK;
+}
+
+ail_error_e ail_appinfo_get_bool(const ail_appinfo_h handle, const char *property, bool *value)
+{
+	int index = fake_ail_find_property(property, FAKE_AIL_TYPE_BOOL);
+
+	if (handle == NULL || value == NULL || index < 0)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	*value = atoi(handle->values[index]) != 0;
+
+	return AIL_ERROR_OK;
+}
+
+ail_error_e ail_appinfo_get_int(const ail_appinfo_h handle, const char *property, int *value)
+{
+	int index = fake_ail_find_property(property, FAKE_AIL_TYPE_INT);
+
+	if (handle == NULL || value == NULL || index < 0)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	*value = atoi(handle->values[index]);
+
+	return AIL_ERROR_OK;
+}
+
+ail_error_e ail_filter_new(ail_filter_h *filter)
+{
+	if (filter == NULL)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	*filter = calloc(1, sizeof(struct ail_filter));
+
+	return *filter != NULL ? AIL_ERROR_OK : AIL_ERROR_OUT_OF_MEMORY;
+}
+
+ail_error_e ail_filter_destroy(ail_filter_h filter)
+{
+	fake_ail_condition_s *condition;
+
+	if (filter == NULL)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	while (filter->conditions != NULL)
+	{
+		condition = filter->conditions;
+		filter->conditions = condition->next;
+		free(condition->value);
+		free(condition);
+	}
+
+	free(filter);
+
+	return AIL_ERROR_OK;
+}
+
+static ail_error_e fake_ail_filter_add(ail_filter_h filter, int property, const char *value)
+{
+	fake_ail_condition_s *condition;
+
+	if (filter == NULL || property < 0 || value == NULL)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	condition = calloc(1, sizeof(fake_ail_condition_s));
+
+	if (condition == NULL)
+	{
+		return AIL_ERROR_OUT_OF_MEMORY;
+	}
+
+	condition->property = property;
+	condition->value = strdup(value);
+
+	if (condition->value == NULL)
+	{
+		free(condition);
+		return AIL_ERROR_OUT_OF_MEMORY;
+	}
+
+	/* conditions are AND-ed, the same way the real filter joins them */
+	condition->next = filter->conditions;
+	filter->conditions = condition;
+
+	return AIL_ERROR_OK;
+}
+
+ail_error_e ail_filter_add_bool(ail_filter_h filter, const char *property, bool value)
+{
+	return fake_ail_filter_add(filter, fake_ail_find_property(property, FAKE_AIL_TYPE_BOOL), value ? "1" : "0");
+}
+
+ail_error_e ail_filter_add_int(ail_filter_h filter, const char *property, int value)
+{
+	char buffer[16];
+
+	snprintf(buffer, sizeof(buffer), "%d", value);
+
+	return fake_ail_filter_add(filter, fake_ail_find_property(property, FAKE_AIL_TYPE_INT), buffer);
+}
+
+ail_error_e ail_filter_add_str(ail_filter_h filter, const char *property, const char *value)
+{
+	return fake_ail_filter_add(filter, fake_ail_find_property(property, FAKE_AIL_TYPE_STR), value);
+}
+
+static sqlite3_stmt *fake_ail_prepare_filter_locked(ail_filter_h filter, const char *columns)
+{
+	char query[1024];
+	int length;
+	int index;
+	fake_ail_condition_s *condition;
+	sqlite3 *conn;
+	sqlite3_stmt *stmt;
+
+	conn = fake_ail_get_db_locked();
+
+	if (conn == NULL)
+	{
+		return NULL;
+	}
+
+	length = snprintf(query, sizeof(query), "SELECT %s FROM app_info", columns);
+
+	for (condition = filter != NULL ? filter->conditions : NULL; condition != NULL; condition = condition->next)
+	{
+		length += snprintf(query + length, sizeof(query) - length, "%s %s = ?",
+				condition == filter->conditions ? " WHERE" : " AND", fake_ail_properties[condition->property].column);
+
+		if (length >= (int)sizeof(query))
+		{
+			return NULL;
+		}
+	}
+
+	if (sqlite3_prepare_v2(conn, query, -1, &stmt, NULL) != SQLITE_OK)
+	{
+		LOGE("[%s] failed to prepare '%s' : %s", __FUNCTION__, query, sqlite3_errmsg(conn));
+		return NULL;
+	}
+
+	for (index = 1, condition = filter != NULL ? filter->conditions : NULL; condition != NULL; condition = condition->next, index++)
+	{
+		sqlite3_bind_text(stmt, index, condition->value, -1, SQLITE_TRANSIENT);
+	}
+
+	return stmt;
+}
+
+ail_error_e ail_filter_count_appinfo(ail_filter_h filter, int *count)
+{
+	sqlite3_stmt *stmt;
+
+	if (count == NULL)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	fake_backend_query();
+
+	fake_ail_lock();
+
+	stmt = fake_ail_prepare_filter_locked(filter, "COUNT(*)");
+
+	if (stmt == NULL || sqlite3_step(stmt) != SQLITE_ROW)
+	{
+		sqlite3_finalize(stmt);
+		fake_ail_unlock();
+		return AIL_ERROR_DB_FAILED;
+	}
+
+	*count = sqlite3_column_int(stmt, 0);
+
+	sqlite3_finalize(stmt);
+
+	fake_ail_unlock();
+
+	return AIL_ERROR_OK;
+}
+
+ail_error_e ail_filter_list_appinfo_foreach(ail_filter_h filter, ail_list_appinfo_cb appinfo_func, void *user_data)
+{
+	sqlite3_stmt *stmt;
+	ail_appinfo_h appinfo;
+	ail_cb_ret_e cb_ret = AIL_CB_RET_CONTINUE;
+
+	if (appinfo_func == NULL)
+	{
+		return AIL_ERROR_INVALID_PARAMETER;
+	}
+
+	fake_backend_query();
+
+	fake_ail_lock();
+
+	stmt = fake_ail_prepare_filter_locked(filter, FAKE_AIL_COLUMNS);
+
+	if (stmt == NULL)
+	{
+		fake_ail_unlock();
+		return AIL_ERROR_DB_FAILED;
+	}
+
+	while (cb_ret == AIL_CB_RET_CONTINUE && sqlite3_step(stmt) == SQLITE_ROW)
+	{
+		appinfo = fake_ail_appinfo_from_row(stmt);
+
+		if (appinfo == NULL)
+		{
+			break;
+		}
+
+		cb_ret = appinfo_func(appinfo, user_data);
+
+		ail_package_destroy_appinfo(appinfo);
+	}
+
+	sqlite3_finalize(stmt);
+
+	fake_ail_unlock();
+
+	return AIL_ERROR_OK;
+}
+
+int fake_ail_install_app(const char *app_id, const char *name, const char *icon, const char *version,
+		const char *type, bool nodisplay, bool taskmanage)
+{
+	sqlite3 *conn;
+	sqlite3_stmt *stmt;
+	char exec[256];
+	int retval;
+
+	if (app_id == NULL)
+	{
+		return -1;
+	}
+
+	snprintf(exec, sizeof(exec), "/opt/apps/%s/bin/%s", app_id, app_id);
+
+	fake_ail_lock();
+
+	conn = fake_ail_get_db_locked();
+
+	if (conn == NULL || sqlite3_prepare_v2(conn,
+			"INSERT OR REPLACE INTO app_info (package, exec, name, type, icon, version, nodisplay, x_slp_taskmanage) "
+			"VALUES (?, ?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL) != SQLITE_OK)
+	{
+		fake_ail_unlock();
+		return -1;
+	}
+
+	sqlite3_bind_text(stmt, 1, app_id, -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt, 2, exec, -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt, 3, name != NULL ? name : app_id, -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt, 4, type != NULL ? type : "capp", -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt, 5, icon != NULL ? icon : "", -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt, 6, version != NULL ? version : "", -1, SQLITE_TRANSIENT);
+	sqlite3_bind_int(stmt, 7, nodisplay ? 1 : 0);
+	sqlite3_bind_int(stmt, 8, taskmanage ? 1 : 0);
+
+	retval = sqlite3_step(stmt) == SQLITE_DONE ? 0 : -1;
+
+	sqlite3_finalize(stmt);
+
+	fake_ail_unlock();
+
+	return retval;
+}
+
+int fake_ail_uninstall_app(const char *app_id)
+{
+	sqlite3 *conn;
+	sqlite3_stmt *stmt;
+	int retval;
+
+	if (app_id == NULL)
+	{
+		return -1;
+	}
+
+	fake_ail_lock();
+
+	conn = fake_ail_get_db_locked();
+
+	if (conn == NULL || sqlite3_prepare_v2(conn, "DELETE FROM app_info WHERE package = ?", -1, &stmt, NULL) != SQLITE_OK)
+	{
+		fake_ail_unlock();
+		return -1;
+	}
+
+	sqlite3_bind_text(stmt, 1, app_id, -1, SQLITE_TRANSIENT);
+
+	retval = (sqlite3_step(stmt) == SQLITE_DONE && sqlite3_changes(conn) > 0) ? 0 : -1;
+
+	sqlite3_finalize(stmt);
+
+	fake_ail_unlock();
+
+	return retval;
+}
+
+void fake_ail_clear_apps(void)
+{
+	sqlite3 *conn;
+
+	fake_ail_lock();
+
+	conn = fake_ail_get_db_locked();
+
+	if (conn != NULL)
+	{
+		sqlite3_exec(conn, "DELETE FROM app_info", NULL, NULL, NULL);
+	}
+
+	fake_ail_unlock();
+}
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <aul.h>
+
+#include <fake_backend.h>
+#include "fake_backend_private.h"
+
+typedef struct _fake_process_ {
+	aul_app_info info;
+	struct _fake_process_ *next;
+} fake_process_s;
+
+static pthread_mutex_t process_mutex = PTHREAD_MUTEX_INITIALIZER;
+static fake_process_s *process_list = NULL;
+static fake_process_s **process_tail = &process_list;
+static int process_count = 0;
+
+static int (*launch_signal_cb)(int, void *) = NULL;
+static void *launch_signal_data = NULL;
+static int (*dead_signal_cb)(int, void *) = NULL;
+static void *dead_signal_data = NULL;
+
+static fake_process_s *fake_aul_find_locked(int pid, fake_process_s ***link)
+{
+	fake_process_s **iter;
+
+	for (iter = &process_list; *iter != NULL; iter = &(*iter)->next)
+	{
+		if ((*iter)->info.pid == pid)
+		{
+			if (link != NULL)
+			{
+				*link = iter;
+			}
+
+			return *iter;
+		}
+	}
+
+	return NULL;
+}
+
+static void fake_aul_free_process(fake_process_s *process)
+{
+	free(process->info.pkg_name);
+	free(process->info.app_path);
+	free(process);
+}
+
+int fake_aul_add_running_app(int pid, const char *app_id)
+{
+	fake_process_s *process;
+	char path[256];
+
+	if (pid <= 0 || app_id == NULL)
+	{
+		return -1;
+	}
+
+	process = calloc(1, sizeof(fake_process_s));
+
+	if (process == NULL)
+	{
+		return -1;
+	}
+
+	snprintf(path, sizeof(path), "/opt/apps/%s/bin/%s", app_id, app_id);
+
+	process->info.pid = pid;
+	process->info.pkg_name = strdup(app_id);
+	process->info.app_path = strdup(path);
+
+	if (process->info.pkg_name == NULL || process->info.app_path == NULL)
+	{
+		fake_aul_free_process(process);
+		return -1;
+	}
+
+	pthread_mutex_lock(&process_mutex);
+
+	if (fake_aul_find_locked(pid, NULL) != NULL)
+	{
+		pthread_mutex_unlock(&process_mutex);
+		fake_aul_free_process(process);
+		return -1;
+	}
+
+	*process_tail = process;
+	process_tail = &process->next;
+	process_count++;
+
+	pthread_mutex_unlock(&process_mutex);
+
+	return 0;
+}
+
+static int fake_aul_remove_running_app(int pid)
+{
+	fake_process_s *process;
+	fake_process_s **link;
+
+	pthread_mutex_lock(&process_mutex);
+
+	process = fake_aul_find_locked(pid, &link);
+
+	if (process != NULL)
+	{
+		*link = process->next;
+
+		if (process_tail == &process->next)
+		{
+			process_tail = link;
+		}
+
+		process_count--;
+	}
+
+	pthread_mutex_unlock(&process_mutex);
+
+	if (process == NULL)
+	{
+		return -1;
+	}
+
+	fake_aul_free_process(process);
+
+	return 0;
+}
+
+void fake_aul_clear_running_apps(void)
+{
+	fake_process_s *process;
+
+	pthread_mutex_lock(&process_mutex);
+
+	while (process_list != NULL)
+	{
+		process = process_list;
+		process_list = process->next;
+		fake_aul_free_process(process);
+	}
+
+	process_tail = &process_list;
+	process_count = 0;
+
+	pthread_mutex_unlock(&process_mutex);
+}
+
+int fake_aul_get_running_app_count(void)
+{
+	int count;
+
+	pthread_mutex_lock(&process_mutex);
+	count = process_count;
+	pthread_mutex_unlock(&process_mutex);
+
+	return count;
+}
+
+void fake_aul_emit_launch_signal(int pid)
+{
+	if (launch_signal_cb != NULL)
+	{
+		launch_signal_cb(pid, launch_signal_data);
+	}
+}
+
+void fake_aul_emit_dead_signal(int pid)
+{
+	if (dead_signal_cb != NULL)
+	{
+		dead_signal_cb(pid, dead_signal_data);
+	}
+}
+
+int fake_aul_launch_app(int pid, const char *app_id)
+{
+	if (fake_aul_add_running_app(pid, app_id) != 0)
+	{
+		return -1;
+	}
+
+	fake_aul_emit_launch_signal(pid);
+
+	return 0;
+}
+
+int fake_aul_terminate_app(int pid)
+{
+	if (fake_aul_remove_running_app(pid) != 0)
+	{
+		return -1;
+	}
+
+	fake_aul_emit_dead_signal(pid);
+
+	return 0;
+}
+
+int aul_app_get_running_app_info(aul_app_info_iter_fn iter_fn, void *user_param)
+{
+	aul_app_info *infos;
+	int count;
+	int i;
+	fake_process_s *process;
+
+	if (iter_fn == NULL)
+	{
+		return AUL_R_EINVAL;
+	}
+
+	fake_backend_ipc();
+
+	/* like the real daemon reply, the iteration runs on a private copy */
+	pthread_mutex_lock(&process_mutex);
+
+	infos = calloc(process_count > 0 ? process_count : 1, sizeof(aul_app_info));
+
+	if (infos == NULL)
+	{
+		pthread_mutex_unlock(&process_mutex);
+		return AUL_R_ERROR;
+	}
+
+	for (count = 0, process = process_list; process != NULL; process = process->next, count++)
+	{
+		infos[count].pid = process->info.pid;
+		infos[count].pkg_name = strdup(process->info.pkg_name);
+		infos[count].app_path = strdup(process->info.app_path);
+	}
+
+	pthread_mutex_unlock(&process_mutex);
+
+	for (i = 0; i < count; i++)
+	{
+		if (infos[i].pkg_name != NULL && infos[i].app_path != NULL)
+		{
+			iter_fn(&infos[i], user_param);
+		}
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		free(infos[i].pkg_name);
+		free(infos[i].app_path);
+	}
+
+	free(infos);
+
+	return AUL_R_OK;
+}
+
+int aul_app_is_running(const char *pkgname)
+{
+	fake_process_s *process;
+	int running = 0;
+
+	if (pkgname == NULL)
+	{
+		return 0;
+	}
+
+	fake_backend_ipc();
+
+	pthread_mutex_lock(&process_mutex);
+
+	for (process = process_list; process != NULL; process = process->next)
+	{
+		if (!strcmp(process->info.pkg_name, pkgname))
+		{
+			running = 1;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&process_mutex);
+
+	return running;
+}
+
+int aul_app_get_pkgname_bypid(int pid, char *pkgname, int len)
+{
+	fake_process_s *process;
+	int retval = AUL_R_ERROR;
+
+	if (pkgname == NULL || len <= 0)
+	{
+		return AUL_R_EINVAL;
+	}
+
+	fake_backend_ipc();
+
+	pthread_mutex_lock(&process_mutex);
+
+	process = fake_aul_find_locked(pid, NULL);
+
+	if (process != NULL)
+	{
+		snprintf(pkgname, len, "%s", process->info.pkg_name);
+		retval = AUL_R_OK;
+	}
+
+	pthread_mutex_unlock(&process_mutex);
+
+	return retval;
+}
+
+int aul_listen_app_launch_signal(int (*func) (int, void *), void *data)
+{
+	launch_signal_cb = func;
+	launch_signal_data = data;
+
+	return AUL_R_OK;
+}
+
+int aul_listen_app_dead_signal(int (*func) (int, void *), void *data)
+{
+	dead_signal_cb = func;
+	dead_signal_data = data;
+
+	return AUL_R_OK;
+}
+
+int aul_resume_app(const char *pkgname)
+{
+	if (pkgname == NULL)
+	{
+		return AUL_R_EINVAL;
+	}
+
+	return aul_app_is_running(pkgname) ? AUL_R_OK : AUL_R_ENOAPP;
+}
+
+int aul_terminate_pid(int pid)
+{
+	fake_backend_ipc();
+
+	return fake_aul_terminate_app(pid) == 0 ? AUL_R_OK : AUL_R_ERROR;
+}
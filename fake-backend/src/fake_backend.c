@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include <dlog.h>
+
+#include <fake_backend.h>
+#include "fake_backend_private.h"
+
+static volatile unsigned int ipc_latency_usec = 0;
+static volatile unsigned long ipc_count = 0;
+static volatile unsigned long query_count = 0;
+
+static void fake_backend_spin(void)
+{
+	struct timespec start, now;
+	long elapsed_usec;
+
+	if (ipc_latency_usec == 0)
+	{
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed_usec = (now.tv_sec - start.tv_sec) * 1000000L + (now.tv_nsec - start.tv_nsec) / 1000L;
+	} while (elapsed_usec < (long)ipc_latency_usec);
+}
+
+void fake_backend_ipc(void)
+{
+	__sync_fetch_and_add(&ipc_count, 1);
+	fake_backend_spin();
+}
+
+void fake_backend_query(void)
+{
+	__sync_fetch_and_add(&query_count, 1);
+	fake_backend_spin();
+}
+
+void fake_backend_set_ipc_latency(unsigned int usec)
+{
+	ipc_latency_usec = usec;
+}
+
+unsigned long fake_backend_get_ipc_count(void)
+{
+	return __sync_fetch_and_add(&ipc_count, 0);
+}
+
+unsigned long fake_backend_get_query_count(void)
+{
+	return __sync_fetch_and_add(&query_count, 0);
+}
+
+void fake_backend_reset_counters(void)
+{
+	__sync_lock_test_and_set(&ipc_count, 0);
+	__sync_lock_test_and_set(&query_count, 0);
+}
+
+void fake_backend_app_id(int index, char *buffer, int size)
+{
+	snprintf(buffer, size, "org.tizen.fake%05d", index);
+}
+
+int fake_backend_populate(int installed, int running)
+{
+	char app_id[64];
+	char name[64];
+	char icon[128];
+	int i;
+
+	if (installed < 0 || running < 0 || running > installed)
+	{
+		return -1;
+	}
+
+	fake_aul_clear_running_apps();
+	fake_ail_clear_apps();
+
+	for (i = 0; i < installed; i++)
+	{
+		fake_backend_app_id(i, app_id, sizeof(app_id));
+		snprintf(name, sizeof(name), "Fake application %d", i);
+		snprintf(icon, sizeof(icon), "/opt/share/icons/default/small/%s.png", app_id);
+
+		if (fake_ail_install_app(app_id, name, icon, "1.0.0", "capp", (i % 10) == 9, (i % 7) != 6) != 0)
+		{
+			return -1;
+		}
+
+		if (i < running && fake_aul_add_running_app(1000 + i, app_id) != 0)
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+int fake_dlog_print(log_priority prio, const char *tag, const char *fmt, ...)
+{
+	static const char prio_char[] = { 'D', 'I', 'W', 'E' };
+	static int threshold = -1;
+	va_list ap;
+
+	if (threshold < 0)
+	{
+		const char *level = getenv("FAKE_DLOG_LEVEL");
+		const char *levels = "DIWES";
+		const char *found = (level != NULL && level[0] != '\0') ? strchr(levels, level[0]) : NULL;
+
+		threshold = DLOG_DEBUG + (found != NULL ? (int)(found - levels) : 1);
+	}
+
+	if ((int)prio < threshold)
+	{
+		return 0;
+	}
+
+	fprintf(stderr, "%c/%s: ", prio_char[prio - DLOG_DEBUG], tag);
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+
+	return 0;
+}
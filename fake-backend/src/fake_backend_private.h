@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+#ifndef __FAKE_BACKEND_PRIVATE_H__
+#define __FAKE_BACKEND_PRIVATE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void fake_backend_ipc(void);
+
+void fake_backend_query(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAKE_BACKEND_PRIVATE_H__ */
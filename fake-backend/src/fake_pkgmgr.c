@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <package-manager.h>
+
+#include <fake_backend.h>
+
+typedef struct _fake_pkgmgr_client_ {
+	client_type type;
+	pkgmgr_handler handler;
+	void *data;
+	struct _fake_pkgmgr_client_ *next;
+} fake_pkgmgr_client_s;
+
+static pthread_mutex_t client_mutex = PTHREAD_MUTEX_INITIALIZER;
+static fake_pkgmgr_client_s *client_list = NULL;
+
+pkgmgr_client *pkgmgr_client_new(client_type ctype)
+{
+	fake_pkgmgr_client_s *client;
+
+	client = calloc(1, sizeof(fake_pkgmgr_client_s));
+
+	if (client == NULL)
+	{
+		return NULL;
+	}
+
+	client->type = ctype;
+
+	pthread_mutex_lock(&client_mutex);
+	client->next = client_list;
+	client_list = client;
+	pthread_mutex_unlock(&client_mutex);
+
+	return client;
+}
+
+int pkgmgr_client_free(pkgmgr_client *pc)
+{
+	fake_pkgmgr_client_s **iter;
+	fake_pkgmgr_client_s *client = pc;
+
+	if (client == NULL)
+	{
+		return PKGMGR_R_EINVAL;
+	}
+
+	pthread_mutex_lock(&client_mutex);
+
+	for (iter = &client_list; *iter != NULL; iter = &(*iter)->next)
+	{
+		if (*iter == client)
+		{
+			*iter = client->next;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&client_mutex);
+
+	free(client);
+
+	return PKGMGR_R_OK;
+}
+
+int pkgmgr_client_listen_status(pkgmgr_client *pc, pkgmgr_handler event_cb, void *data)
+{
+	fake_pkgmgr_client_s *client = pc;
+
+	if (client == NULL || event_cb == NULL || client->type != PC_LISTENING)
+	{
+		return PKGMGR_R_EINVAL;
+	}
+
+	client->handler = event_cb;
+	client->data = data;
+
+	return PKGMGR_R_OK;
+}
+
+int fake_pkgmgr_get_listener_count(void)
+{
+	fake_pkgmgr_client_s *client;
+	int count = 0;
+
+	pthread_mutex_lock(&client_mutex);
+
+	for (client = client_list; client != NULL; client = client->next)
+	{
+		if (client->type == PC_LISTENING && client->handler != NULL)
+		{
+			count++;
+		}
+	}
+
+	pthread_mutex_unlock(&client_mutex);
+
+	return count;
+}
+
+void fake_pkgmgr_emit(int req_id, const char *pkg_type, const char *package, const char *key, const char *val)
+{
+	fake_pkgmgr_client_s *client;
+	fake_pkgmgr_client_s *next;
+
+	/* the handlers run unlocked so that they can (un)register listeners */
+	pthread_mutex_lock(&client_mutex);
+	client = client_list;
+	pthread_mutex_unlock(&client_mutex);
+
+	for (; client != NULL; client = next)
+	{
+		next = client->next;
+
+		if (client->type == PC_LISTENING && client->handler != NULL)
+		{
+			client->handler(req_id, pkg_type, package, key, val, NULL, client->data);
+		}
+	}
+}
+
+void fake_pkgmgr_emit_operation(int req_id, const char *operation, const char *package)
+{
+	fake_pkgmgr_emit(req_id, "rpm", package, "start", operation);
+	fake_pkgmgr_emit(req_id, "rpm", package, "end", "ok");
+}
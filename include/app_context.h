@@ -44,6 +44,23 @@ extern "C" {
 typedef struct app_context_s *app_context_h;
 
 
+/**
+ * @brief Running application snapshot handle.
+ */
+typedef struct app_context_snapshot_s *app_context_snapshot_h;
+
+
+/**
+ * @brief The record of a running application in a snapshot.
+ * @see app_context_snapshot_get_records()
+ */
+typedef struct
+{
+	pid_t pid; /**< The process ID of the application */
+	const char *app_id; /**< The ID of the application */
+} app_context_record_s;
+
+
 /**
  * @brief Enumerations of event type for the application context event
  */
@@ -95,6 +112,19 @@ int app_context_get_package(app_context_h app_context, char **package);
 int app_context_get_app_id(app_context_h app_context, char **app_id);
 
 
+/**
+ * @brief Gets the application ID with the given application context without copying it.
+ * @remarks @a app_id is owned by @a app_context. It must not be modified or released, and is valid until app_context_destroy() is called.
+ * @param [in] app_context The application context
+ * @param [out] app_id The application ID of the given application context
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see app_context_get_app_id()
+ */
+int app_context_get_app_id_peek(app_context_h app_context, const char **app_id);
+
+
 /**
  * @brief Gets the process ID with the given application context.
  * @param [in] app_context The application context
@@ -137,6 +167,7 @@ int app_context_is_equal(app_context_h lhs, app_context_h rhs, bool *equal);
 
 /**
  * @brief Clones the application context handle.
+ * @remarks The clone may share its data with @a app_context. Each of them must be released with app_context_destroy().
  * @param [out] clone If successful, a newly created application context handle will be returned.
  * @param [in] app_context The application context
  * @return 0 on success, otherwise a negative error value.
@@ -148,6 +179,32 @@ int app_context_is_equal(app_context_h lhs, app_context_h rhs, bool *equal);
 int app_context_clone(app_context_h *clone, app_context_h app_context);
 
 
+/**
+ * @brief Gets the records of the running applications in the snapshot.
+ * @remarks @a records is an array of @a count records owned by @a snapshot. \n
+ * The array and the application IDs it points to must not be modified or released, and are valid until app_context_snapshot_destroy() is called.
+ * @param [in] snapshot The running application snapshot
+ * @param [out] records The records of the running applications
+ * @param [out] count The number of records
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see app_manager_get_running_app_snapshot()
+ */
+int app_context_snapshot_get_records(app_context_snapshot_h snapshot, const app_context_record_s **records, int *count);
+
+
+/**
+ * @brief Destroys the running application snapshot and releases all its resources.
+ * @param [in] snapshot The running application snapshot
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see app_manager_get_running_app_snapshot()
+ */
+int app_context_snapshot_destroy(app_context_snapshot_h snapshot);
+
+
 /**
  * @}
  */
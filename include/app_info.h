@@ -42,6 +42,42 @@ typedef enum
 } app_info_event_e;
 
 
+/**
+ * @brief Application information table handle.
+ */
+typedef struct app_info_table_s *app_info_table_h;
+
+
+/**
+ * @brief Enumerations of the application properties which can be requested in an application information table
+ */
+typedef enum
+{
+	APP_INFO_PROPERTY_NAME = 0x01, /**< The name of the application */
+	APP_INFO_PROPERTY_ICON = 0x02, /**< The absolute path to the icon image */
+	APP_INFO_PROPERTY_VERSION = 0x04, /**< The version of the application */
+} app_info_property_e;
+
+
+/**
+ * @brief Application information filter handle.
+ */
+typedef struct app_info_filter_s *app_info_filter_h;
+
+
+/**
+ * @brief Enumerations of the application properties an application information filter can match
+ */
+typedef enum
+{
+	APP_INFO_FILTER_PROPERTY_TYPE, /**< The type of the application, such as "capp" or "webapp" (string) */
+	APP_INFO_FILTER_PROPERTY_PACKAGE_TYPE, /**< The type of the package, such as "rpm" or "wgt" (string) */
+	APP_INFO_FILTER_PROPERTY_NODISPLAY, /**< Whether the application is hidden from the menu (boolean) */
+	APP_INFO_FILTER_PROPERTY_TASKMANAGE, /**< Whether the application is shown in the task manager (boolean) */
+	APP_INFO_FILTER_PROPERTY_REMOVABLE, /**< Whether the application can be uninstalled (boolean) */
+} app_info_filter_property_e;
+
+
 /**
  * @brief Destroys the application information handle and releases all its resources.
  * @param [in] app_info The application information handle
@@ -68,6 +104,19 @@ int app_info_destroy(app_info_h app_info);
 int app_info_get_app_id(app_info_h app_info, char **app_id);
 
 
+/**
+ * @brief Gets the application ID with the given application information without copying it.
+ * @remarks @a app_id is owned by @a app_info. It must not be modified or released, and is valid until app_info_destroy() is called.
+ * @param [in] app_info The application information
+ * @param [out] app_id The application ID of the given application information
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see app_info_get_app_id()
+ */
+int app_info_get_app_id_peek(app_info_h app_info, const char **app_id);
+
+
 /**
  * @brief Gets the name of the application
  * @remarks @a name must be released with free() by you.
@@ -76,12 +125,28 @@ int app_info_get_app_id(app_info_h app_info, char **app_id);
  * @return 0 on success, otherwise a negative error value.
  * @retval #APP_MANAGER_ERROR_NONE Successful
  * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP The application is not installed
  * @retval #APP_MANAGER_ERROR_DB_FAILED Database error occurred
  * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
  */
 int app_info_get_name(app_info_h app_info, char **name);
 
 
+/**
+ * @brief Gets the name of the application without copying it.
+ * @remarks @a name is owned by @a app_info. It must not be modified or released, and is valid until app_info_destroy() is called.
+ * @param [in] app_info The application information
+ * @param [out] name The name of the application
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP The application is not installed
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Internal I/O error
+ * @see app_info_get_name()
+ */
+int app_info_get_name_peek(app_info_h app_info, const char **name);
+
+
 /**
  * @brief Gets the version of the application
  * @remarks @a version must be released with free() by you.
@@ -90,12 +155,28 @@ int app_info_get_name(app_info_h app_info, char **name);
  * @return 0 on success, otherwise a negative error value.
  * @retval #APP_MANAGER_ERROR_NONE Successful
  * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP The application is not installed
  * @retval #APP_MANAGER_ERROR_DB_FAILED Database error occurred
  * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
  */
 int app_info_get_version(app_info_h app_info, char **version);
 
 
+/**
+ * @brief Gets the version of the application without copying it.
+ * @remarks @a version is owned by @a app_info. It must not be modified or released, and is valid until app_info_destroy() is called.
+ * @param [in] app_info The application information
+ * @param [out] version The version of the application
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP The application is not installed
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Internal I/O error
+ * @see app_info_get_version()
+ */
+int app_info_get_version_peek(app_info_h app_info, const char **version);
+
+
 /**
  * @brief Gets the absolute path to the icon image
  * @remarks @a path must be released with free() by you.
@@ -104,12 +185,28 @@ int app_info_get_version(app_info_h app_info, char **version);
  * @return 0 on success, otherwise a negative error value.
  * @retval #APP_MANAGER_ERROR_NONE Successful
  * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP The application is not installed
  * @retval #APP_MANAGER_ERROR_DB_FAILED Database error occurred
  * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
  */
 int app_info_get_icon(app_info_h app_info, char **path);
 
 
+/**
+ * @brief Gets the absolute path to the icon image without copying it.
+ * @remarks @a path is owned by @a app_info. It must not be modified or released, and is valid until app_info_destroy() is called.
+ * @param [in] app_info The application information
+ * @param [out] path The absolute path to the icon
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP The application is not installed
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Internal I/O error
+ * @see app_info_get_icon()
+ */
+int app_info_get_icon_peek(app_info_h app_info, const char **path);
+
+
 /**
  * @brief Checks whether two application information are equal.
  * @param [in] lhs	The first application information to compare
@@ -126,6 +223,7 @@ int app_info_is_equal(app_info_h lhs, app_info_h rhs, bool *equal);
 
 /**
  * @brief Clones the application information handle.
+ * @remarks The clone may share its data with @a app_info. Each of them must be released with app_info_destroy().
  * @param [out] clone If successful, a newly created application information handle will be returned.
  * @param [in] app_info The application information
  * @return 0 on success, otherwise a negative error value.
@@ -137,6 +235,98 @@ int app_info_is_equal(app_info_h lhs, app_info_h rhs, bool *equal);
 int app_info_clone(app_info_h *clone, app_info_h app_info);
 
 
+/**
+ * @brief Creates an application information filter which matches every installed application.
+ * @remarks @a filter must be released with app_info_filter_destroy() by you.
+ * @param [out] filter The application information filter
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @see app_manager_foreach_app_info_by_filter()
+ */
+int app_info_filter_create(app_info_filter_h *filter);
+
+
+/**
+ * @brief Destroys the application information filter and releases all its resources.
+ * @param [in] filter The application information filter
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int app_info_filter_destroy(app_info_filter_h filter);
+
+
+/**
+ * @brief Restricts the filter to the applications whose boolean property has the given value.
+ * @remarks The conditions added to a filter must all be met.
+ * @param [in] filter The application information filter
+ * @param [in] property A boolean property
+ * @param [in] value The value to match
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter, or @a property is not a boolean property
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ */
+int app_info_filter_add_bool(app_info_filter_h filter, app_info_filter_property_e property, bool value);
+
+
+/**
+ * @brief Restricts the filter to the applications whose string property has the given value.
+ * @remarks The conditions added to a filter must all be met.
+ * @param [in] filter The application information filter
+ * @param [in] property A string property
+ * @param [in] value The value to match
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter, or @a property is not a string property
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ */
+int app_info_filter_add_string(app_info_filter_h filter, app_info_filter_property_e property, const char *value);
+
+
+/**
+ * @brief Restricts the filter to one page of the matching applications.
+ * @remarks The applications are listed in the order of the database, which is stable as long as no application is installed or uninstalled.
+ * @param [in] filter The application information filter
+ * @param [in] offset The number of matching applications to skip
+ * @param [in] limit The largest number of applications to list, or a negative value for no limit
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int app_info_filter_set_range(app_info_filter_h filter, int offset, int limit);
+
+
+/**
+ * @brief Gets a property of an application in the application information table.
+ * @remarks @a value is owned by @a table. It must not be released, and is valid until app_info_table_destroy() is called.
+ * @param [in] table The application information table
+ * @param [in] index The position of the application in the application ID array the table was created with
+ * @param [in] property The property, which must have been requested when the table was created
+ * @param [out] value The value of the property
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP The application is not installed
+ * @retval #APP_MANAGER_ERROR_IO_ERROR The application does not have the property
+ * @see app_manager_get_app_info_table()
+ */
+int app_info_table_get_value(app_info_table_h table, int index, app_info_property_e property, const char **value);
+
+
+/**
+ * @brief Destroys the application information table and releases all its resources.
+ * @param [in] table The application information table
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see app_manager_get_app_info_table()
+ */
+int app_info_table_destroy(app_info_table_h table);
+
+
 #ifdef __cplusplus
 }
 #endif
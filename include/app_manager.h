@@ -51,6 +51,34 @@ typedef enum
 } app_manager_error_e;
 
 
+/**
+ * @internal
+ * @brief Enumerations of the ways the application context events are delivered.
+ */
+typedef enum
+{
+	APP_MANAGER_EVENT_DISPATCH_SYNC = 0, /**< The callback is invoked on the thread receiving the launch and dead signals */
+	APP_MANAGER_EVENT_DISPATCH_ASYNC, /**< The callback is invoked on a dispatcher thread of the library */
+} app_manager_event_dispatch_mode_e;
+
+
+/**
+ * @brief Application context event subscription handle.
+ */
+typedef struct app_context_subscription_s *app_context_subscription_h;
+
+
+/**
+ * @brief Enumerations of the application context events a subscription can select.
+ */
+typedef enum
+{
+	APP_MANAGER_EVENT_MASK_LAUNCHED = 0x01, /**< #APP_CONTEXT_EVENT_LAUNCHED */
+	APP_MANAGER_EVENT_MASK_TERMINATED = 0x02, /**< #APP_CONTEXT_EVENT_TERMINATED */
+	APP_MANAGER_EVENT_MASK_ALL = 0x03, /**< All application context events */
+} app_manager_event_mask_e;
+
+
 /**
  * @brief Called when an application gets launched or termiated.
  * @param[in] app_context The application context of the application launched or termiated
@@ -77,6 +105,7 @@ typedef bool (*app_manager_app_context_cb) (app_context_h app_context, void *use
 /**
  * @internal
  * @brief Called when an application gets installed, terminated or updated.
+ * @remarks The metadata of an uninstalled application cannot be read from @a app_info any more, only its ID.
  * @param[in] app_info The application information of the application installed, terminated or updated
  * @param[in] event The application information event
  * @param[in] user_data The user data passed from the foreach function
@@ -87,9 +116,49 @@ typedef bool (*app_manager_app_context_cb) (app_context_h app_context, void *use
 typedef void (*app_manager_app_info_event_cb) (app_info_h app_info, app_info_event_e event, void *user_data);
 
 
+/**
+ * @internal
+ * @brief Called while an application gets installed, uninstalled or updated.
+ * @param[in] app_id The ID of the application
+ * @param[in] event The operation in progress
+ * @param[in] progress The progress of the operation in percent
+ * @param[in] user_data The user data passed from the callback registration function
+ * @pre This function is called when the package manager reports the progress of an operation after you register this callback using app_manager_set_app_info_progress_cb()
+ * @see app_manager_set_app_info_progress_cb()
+ * @see app_manager_unset_app_info_progress_cb()
+ */
+typedef void (*app_manager_app_info_progress_cb) (const char *app_id, app_info_event_e event, int progress, void *user_data);
+
+
+/**
+ * @internal
+ * @brief The structure type for one application change delivered in a batch.
+ */
+typedef struct
+{
+	const char *app_id; /**< The ID of the application */
+	app_info_event_e event; /**< The change made to the application */
+} app_info_event_record_s;
+
+
+/**
+ * @internal
+ * @brief Called once for a batch of applications installed, uninstalled or updated together.
+ * @remarks @a records is valid only in this function.
+ * @param[in] records The changes in the order they completed
+ * @param[in] count The number of the changes
+ * @param[in] user_data The user data passed from the callback registration function
+ * @pre This function is called when no package operation is in flight any more or the batching window expires after you register this callback using app_manager_set_app_info_batch_event_cb()
+ * @see app_manager_set_app_info_batch_event_cb()
+ * @see app_manager_unset_app_info_batch_event_cb()
+ */
+typedef void (*app_manager_app_info_batch_event_cb) (const app_info_event_record_s *records, int count, void *user_data);
+
+
 /**
  * @internal
  * @brief Called to get the application information once for each installed application.
+ * @remarks @a app_info is valid only in this function. To use it outside, make a copy with app_info_clone().
  * @param[in] app_info The application information of each installed application
  * @param[in] user_data The user data passed from the foreach function
  * @return @c true to continue with the next iteration of the loop, \n @c false to break out of the loop.
@@ -124,6 +193,75 @@ int app_manager_set_app_context_event_cb(app_manager_app_context_event_cb callba
 void app_manager_unset_app_context_event_cb(void);
 
 
+/**
+ * @brief Subscribes to the application context events of the applications whose ID starts with the given prefix.
+ * @remarks Any number of subscriptions may be active at the same time. They share one table of running applications. \n
+ * The callback registered with app_manager_set_app_context_event_cb() counts as one more subscription. \n
+ * The filters are checked before an event is dispatched, so a subscription is not called for events it does not select. \n
+ * @a subscription must be released with app_manager_unsubscribe_app_context_event() by you.
+ * @param [in] app_id_prefix The prefix of the application IDs to receive the events of, or @c NULL for all applications
+ * @param [in] events The events to receive, a combination of #app_manager_event_mask_e values
+ * @param [in] callback The callback function to invoke
+ * @param [in] user_data The user data to be passed to the callback function
+ * @param [out] subscription The handle of the subscription
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Failed to load the running applications
+ * @post It will invoke app_manager_app_context_event_cb() when a selected application is launched or terminated.
+ * @see app_manager_unsubscribe_app_context_event()
+ */
+int app_manager_subscribe_app_context_event(const char *app_id_prefix, int events,
+		app_manager_app_context_event_cb callback, void *user_data, app_context_subscription_h *subscription);
+
+
+/**
+ * @brief Cancels a subscription to the application context events.
+ * @remarks Once this function returns, the callback is not invoked for any further event. An invocation already in progress on another thread may still be running.
+ * @param [in] subscription The handle of the subscription
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @see app_manager_subscribe_app_context_event()
+ */
+int app_manager_unsubscribe_app_context_event(app_context_subscription_h subscription);
+
+
+/**
+ * @internal
+ * @brief Sets how the application context events are delivered to the registered callback.
+ * @remarks The default is #APP_MANAGER_EVENT_DISPATCH_SYNC. \n
+ * In #APP_MANAGER_EVENT_DISPATCH_ASYNC mode, a slow callback does not delay the signal handling of the process. \n
+ * The events are queued in order, and at most 256 of them are kept pending. Events beyond that are dropped. \n
+ * If an application terminates before its launch event is delivered, neither event is delivered. \n
+ * The dispatcher thread is started on the first switch to #APP_MANAGER_EVENT_DISPATCH_ASYNC and runs until the process exits.
+ * @param [in] mode The dispatch mode
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Failed to start the dispatcher
+ * @see app_manager_set_app_context_event_cb()
+ * @see app_manager_get_app_context_event_stats()
+ */
+int app_manager_set_app_context_event_dispatch_mode(app_manager_event_dispatch_mode_e mode);
+
+
+/**
+ * @internal
+ * @brief Gets the counters of the asynchronous application context event dispatcher
+ * @param [out] dispatched The number of events delivered by the dispatcher
+ * @param [out] coalesced The number of launch and terminate events dropped because the application was already dead
+ * @param [out] dropped The number of events dropped because the queue was full
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see app_manager_set_app_context_event_dispatch_mode()
+ */
+int app_manager_get_app_context_event_stats(unsigned int *dispatched, unsigned int *coalesced, unsigned int *dropped);
+
+
 /**
  * @brief Retrieves all application contexts of running applications
  * @param [in] callback The callback function to invoke
@@ -137,6 +275,21 @@ void app_manager_unset_app_context_event_cb(void);
 int app_manager_foreach_app_context(app_manager_app_context_cb callback, void *user_data);
 
 
+/**
+ * @brief Takes a snapshot of all running applications
+ * @remarks The snapshot is a single immutable block holding the process ID and the application ID of each running application. \n
+ * @a snapshot must be released with app_context_snapshot_destroy() by you.
+ * @param [out] snapshot The snapshot of the running applications
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @see app_context_snapshot_get_records()
+ * @see app_context_snapshot_destroy()
+ */
+int app_manager_get_running_app_snapshot(app_context_snapshot_h *snapshot);
+
+
 /**
  * @brief Gets the application context for the given ID of the application
  * @remarks This function returns #APP_MANAGER_ERROR_NO_SUCH_APP if the application with the given application ID is not running \n
@@ -153,6 +306,23 @@ int app_manager_foreach_app_context(app_manager_app_context_cb callback, void *u
 int app_manager_get_app_context(const char *app_id, app_context_h *app_context);
 
 
+/**
+ * @brief Gets the application context for the given process ID of the application
+ * @remarks This function returns #APP_MANAGER_ERROR_NO_SUCH_APP if no running application has the given process ID \n
+ * While an application context event callback is registered, the lookup is served from the table of running applications without IPC. \n
+ * @a app_context must be released with app_context_destroy() by you.
+ * @param [in] pid The process ID of the application
+ * @param [out] app_context The application context of the given process ID
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP No such application
+ * @see app_manager_get_app_context()
+ */
+int app_manager_get_app_context_by_pid(pid_t pid, app_context_h *app_context);
+
+
 /**
  * @brief Gets the name of the application package for the given process ID of the application
  * @remark This function is @b deprecated. Use app_manager_get_app_id() instead.
@@ -244,6 +414,63 @@ int app_manager_set_app_info_event_cb(app_manager_app_info_event_cb callback, vo
 void app_manager_unset_app_info_event_cb(void);
 
 
+/**
+ * @internal
+ * @brief Registers a callback function to be invoked while the applications get installed, uninstalled or updated.
+ * @remarks Operations running at the same time are reported separately. A percentage is reported once even if the package manager repeats it.
+ * @param[in] callback The callback function to register
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return  0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE On Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Internal I/O error
+ * @post	It will invoke app_manager_app_info_progress_cb() when the package manager reports the progress of an operation.
+ * @see app_manager_unset_app_info_progress_cb()
+ * @see app_manager_app_info_progress_cb()
+ */
+int app_manager_set_app_info_progress_cb(app_manager_app_info_progress_cb callback, void *user_data);
+
+
+/**
+ * @internal
+ * @brief Unregisters the progress callback function.
+ * @see app_manager_set_app_info_progress_cb()
+ * @see app_manager_app_info_progress_cb()
+ */
+void app_manager_unset_app_info_progress_cb(void);
+
+
+/**
+ * @internal
+ * @brief Registers a callback function to be invoked once per batch of installed, uninstalled or updated applications.
+ * @remarks A batch ends when the last package operation in flight ends or when @a window milliseconds have passed since its first change, whichever comes first.
+ * A @a window of 0 ends batches when the package operations end, or after 60 seconds if the end of an operation is never reported.
+ * A batch that holds 256 changes is delivered at once. The same change reported twice within a batch is delivered once.
+ * The window is timed on the default main context, which must be running.
+ * @param[in] window The longest time in milliseconds a change is held back
+ * @param[in] callback The callback function to register
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return  0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE On Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Internal I/O error
+ * @post	It will invoke app_manager_app_info_batch_event_cb() when a batch of applications has been changed.
+ * @see app_manager_unset_app_info_batch_event_cb()
+ * @see app_manager_app_info_batch_event_cb()
+ */
+int app_manager_set_app_info_batch_event_cb(unsigned int window, app_manager_app_info_batch_event_cb callback, void *user_data);
+
+
+/**
+ * @internal
+ * @brief Unregisters the batch callback function.
+ * @remarks Changes collected for the current batch are discarded.
+ * @see app_manager_set_app_info_batch_event_cb()
+ * @see app_manager_app_info_batch_event_cb()
+ */
+void app_manager_unset_app_info_batch_event_cb(void);
+
+
 /**
  * @internal
  * @brief Retrieves all application information of installed applications
@@ -258,6 +485,40 @@ void app_manager_unset_app_info_event_cb(void);
 int app_manager_foreach_app_info(app_manager_app_info_cb callback, void *user_data);
 
 
+/**
+ * @internal
+ * @brief Retrieves the application information of the installed applications the filter matches
+ * @remarks The filter is evaluated by the database, or by the application index when it only has boolean conditions and the index is in use.
+ * No handle is made for an application outside of the page the filter selects.
+ * @param [in] filter The application information filter
+ * @param [in] callback The callback function to invoke
+ * @param [in] user_data The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_DB_FAILED Database error occurred
+ * @post	This function invokes app_manager_app_info_cb() repeatedly for each application information.
+ * @see app_info_filter_create()
+ * @see app_manager_app_info_cb()
+ */
+int app_manager_foreach_app_info_by_filter(app_info_filter_h filter, app_manager_app_info_cb callback, void *user_data);
+
+
+/**
+ * @internal
+ * @brief Counts the installed applications the filter matches
+ * @remarks The count is limited to the page the filter selects.
+ * @param [in] filter The application information filter
+ * @param [out] count The number of matching applications
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_DB_FAILED Database error occurred
+ * @see app_info_filter_create()
+ */
+int app_manager_count_app_info_by_filter(app_info_filter_h filter, int *count);
+
+
 /**
  * @internal
  * @brief Gets the application information for the given application ID
@@ -273,6 +534,114 @@ int app_manager_foreach_app_info(app_manager_app_info_cb callback, void *user_da
 int app_manager_get_app_info(const char *app_id, app_info_h *app_info);
 
 
+/**
+ * @brief Copies a property of the application into the given buffer
+ * @remarks No memory is allocated when the application information is already cached.
+ * @param [in] app_id The ID of the application
+ * @param [in] property The property to get
+ * @param [out] buffer The buffer the null-terminated value is copied into
+ * @param [in] size The size of @a buffer in bytes
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter, or @a buffer is too small for the value
+ * @retval #APP_MANAGER_ERROR_NO_SUCH_APP No such application
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #APP_MANAGER_ERROR_IO_ERROR The application does not have the property
+ */
+int app_manager_get_app_property(const char *app_id, app_info_property_e property, char *buffer, int size);
+
+
+/**
+ * @internal
+ * @brief Gets the properties of several applications at once
+ * @remarks The indexed and cached applications are served from the application index and the cache. If any application is neither,
+ * every application in the database is listed once to find the missing ones, which costs as much as app_manager_foreach_app_info(). \n
+ * A property an application does not have is reported by app_info_table_get_value() as #APP_MANAGER_ERROR_IO_ERROR,
+ * whether the application was found in the index, the cache or the database. \n
+ * All values are packed in @a table, which must be released with app_info_table_destroy() by you.
+ * @param [in] app_ids The IDs of the applications
+ * @param [in] count The number of application IDs
+ * @param [in] properties The bitwise OR of the #app_info_property_e values to get
+ * @param [out] table The application information table
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @see app_info_table_get_value()
+ * @see app_info_table_destroy()
+ */
+int app_manager_get_app_info_table(const char **app_ids, int count, int properties, app_info_table_h *table);
+
+
+/**
+ * @internal
+ * @brief Gets the hit and miss counts of the application information cache
+ * @remarks The application information is cached per application ID and dropped when the package manager reports that the application is installed, uninstalled or updated.
+ * @param [out] hits The number of lookups served from the cache
+ * @param [out] misses The number of lookups that queried the database
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int app_manager_get_app_info_cache_stats(unsigned int *hits, unsigned int *misses);
+
+
+/**
+ * @internal
+ * @brief Sets the file the index of the installed applications is kept in
+ * @remarks The index holds the ID, name, icon, version and flags of every installed application and is mapped into memory,
+ * so the application information is served without querying the database. It is built from the database when it is missing,
+ * unreadable or older than the database, and rebuilt by the first lookup after the package operations in flight end. While packages
+ * change or the index is being rebuilt, the database is queried instead. \n
+ * The directory of @a path must be writable. The processes rebuilding the index take turns through a lock file named after @a path. \n
+ * If @a path is @c NULL, the index is no longer used.
+ * @param [in] path The path to the index file, or @c NULL
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #APP_MANAGER_ERROR_IO_ERROR Internal I/O error
+ */
+int app_manager_set_app_info_index_path(const char *path);
+
+
+/**
+ * @internal
+ * @brief Enumerations of the handle types allocated from a handle pool
+ */
+typedef enum
+{
+	APP_MANAGER_HANDLE_TYPE_APP_CONTEXT, /**< #app_context_h */
+	APP_MANAGER_HANDLE_TYPE_APP_INFO, /**< #app_info_h */
+} app_manager_handle_type_e;
+
+
+/**
+ * @internal
+ * @brief The structure type for the statistics of a handle pool.
+ */
+typedef struct
+{
+	unsigned int slabs; /**< The number of slabs the pool has grown by */
+	unsigned int capacity; /**< The number of handles the slabs hold */
+	unsigned int in_use; /**< The number of handles currently alive */
+	unsigned int peak; /**< The highest number of handles alive at once */
+	unsigned int takes; /**< The number of handles created so far */
+} app_manager_handle_pool_stats_s;
+
+
+/**
+ * @internal
+ * @brief Gets the statistics of the pool the handles of the given type are allocated from
+ * @remarks The pool grows by slabs of handles as needed and keeps them for the lifetime of the process.
+ * @param [in] type The handle type
+ * @param [out] stats The statistics of the pool
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #APP_MANAGER_ERROR_NONE Successful
+ * @retval #APP_MANAGER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int app_manager_get_handle_pool_stats(app_manager_handle_type_e type, app_manager_handle_pool_stats_s *stats);
+
+
 /**
  * @}
  */
@@ -18,6 +18,8 @@
 #ifndef __TIZEN_APPFW_APP_MANAGER_PRIVATE_H__
 #define __TIZEN_APPFW_APP_MANAGER_PRIVATE_H__
 
+#include <pthread.h>
+
 #include <app_context.h>
 #include <app_info.h>
 
@@ -25,24 +27,150 @@
 extern "C" {
 #endif
 
+typedef enum {
+	PACKAGE_EVENT_TYPE_UNKNOWN = -1,
+	PACKAGE_EVENT_TYPE_INSTALL,
+	PACKAGE_EVENT_TYPE_UNINSTALL,
+	PACKAGE_EVENT_TYPE_UPDATE,
+} package_event_type_e;
+
+typedef enum {
+	PACKAGE_EVENT_STATE_STARTED,
+	PACKAGE_EVENT_STATE_PROGRESS,
+	PACKAGE_EVENT_STATE_COMPLETED,
+	PACKAGE_EVENT_STATE_FAILED,
+	PACKAGE_EVENT_STATE_IDLE, // no operation is in flight any more, the package is NULL
+} package_event_state_e;
+
+// a request that has been silent for this many seconds is taken for one whose end message got lost
+#define PACKAGE_EVENT_REQUEST_TIMEOUT 60
+
+#define HANDLE_POOL_SLAB_SIZE 64
+
+typedef struct _handle_pool_ {
+	size_t element_size;
+	pthread_mutex_t mutex;
+	void *free_list;
+	void *slabs;
+	unsigned int slab_count;
+	unsigned int capacity;
+	unsigned int in_use;
+	unsigned int peak;
+	unsigned int takes;
+} handle_pool_s;
+
+#define HANDLE_POOL_INITIALIZER(type) { .element_size = sizeof(type), .mutex = PTHREAD_MUTEX_INITIALIZER }
+
+typedef enum {
+	APP_INFO_INDEX_FIELD_NAME,
+	APP_INFO_INDEX_FIELD_ICON,
+	APP_INFO_INDEX_FIELD_VERSION,
+	APP_INFO_INDEX_FIELD_MAX,
+} app_info_index_field_e;
+
+typedef enum {
+	APP_INFO_INDEX_FLAG_NODISPLAY = 0x01,
+	APP_INFO_INDEX_FLAG_TASKMANAGE = 0x02,
+	APP_INFO_INDEX_FLAG_REMOVABLE = 0x04,
+} app_info_index_flag_e;
+
+typedef struct _app_info_index_ app_info_index_s;
+
+typedef struct _app_info_index_entry_ app_info_index_entry_s;
+
+typedef void (*package_event_cb) (const char *package, package_event_type_e type, package_event_state_e state, int progress, void *user_data);
+
 int app_manager_error(app_manager_error_e error, const char* function, const char *description);
 
+int package_event_add_listener(package_event_cb callback, void *user_data);
+
+bool package_event_is_busy(void);
+
+const char *app_id_table_intern(const char *app_id);
+
+void *handle_pool_take(handle_pool_s *pool);
+
+void handle_pool_release(handle_pool_s *pool, void *element);
+
+void handle_pool_get_stats(handle_pool_s *pool, app_manager_handle_pool_stats_s *stats);
+
+int app_info_index_set_path(const char *path);
+
+app_info_index_s *app_info_index_acquire(void);
+
+app_info_index_s *app_info_index_ref(app_info_index_s *index);
+
+void app_info_index_release(app_info_index_s *index);
+
+int app_info_index_get_count(app_info_index_s *index);
+
+const app_info_index_entry_s *app_info_index_get_entry(app_info_index_s *index, int position);
+
+const app_info_index_entry_s *app_info_index_lookup(app_info_index_s *index, const char *app_id);
+
+const char *app_info_index_get_app_id(app_info_index_s *index, const app_info_index_entry_s *entry);
+
+const char *app_info_index_get_field(app_info_index_s *index, const app_info_index_entry_s *entry, app_info_index_field_e field);
+
+int app_info_index_get_flags(const app_info_index_entry_s *entry);
+
 int app_context_foreach_app_context(app_manager_app_context_cb callback, void *user_data);
 
 int app_context_get_app_context(const char *app_id, app_context_h *app_context);
 
+int app_context_get_app_context_by_pid(pid_t pid, app_context_h *app_context);
+
+int app_context_get_app_id_by_pid(pid_t pid, char **app_id);
+
+int app_context_is_running(const char *app_id, bool *running);
+
+int app_context_get_snapshot(app_context_snapshot_h *snapshot);
+
 int app_context_set_event_cb(app_manager_app_context_event_cb callback, void *user_data);
 
 void app_context_unset_event_cb(void);
 
+int app_context_subscribe_event(const char *app_id_prefix, int events,
+		app_manager_app_context_event_cb callback, void *user_data, app_context_subscription_h *subscription);
+
+int app_context_unsubscribe_event(app_context_subscription_h subscription);
+
+int app_context_set_event_dispatch_mode(app_manager_event_dispatch_mode_e mode);
+
+int app_context_get_event_stats(unsigned int *dispatched, unsigned int *coalesced, unsigned int *dropped);
+
+void app_context_get_pool_stats(app_manager_handle_pool_stats_s *stats);
+
 int app_info_foreach_app_info(app_manager_app_info_cb callback, void *user_data);
 
+int app_info_foreach_app_info_by_filter(app_info_filter_h filter, app_manager_app_info_cb callback, void *user_data);
+
+int app_info_count_app_info_by_filter(app_info_filter_h filter, int *count);
+
 int app_info_get_app_info(const char *app_id, app_info_h *app_info);
 
+int app_info_get_app_info_table(const char **app_ids, int count, int properties, app_info_table_h *table);
+
+int app_info_get_app_property(const char *app_id, app_info_property_e property, char *buffer, int size);
+
+int app_info_dup_app_property(const char *app_id, app_info_property_e property, char **value);
+
 int app_info_set_event_cb(app_manager_app_info_event_cb callback, void *user_data);
 
 void app_info_unset_event_cb(void);
 
+int app_info_set_progress_cb(app_manager_app_info_progress_cb callback, void *user_data);
+
+void app_info_unset_progress_cb(void);
+
+int app_info_set_batch_event_cb(unsigned int window, app_manager_app_info_batch_event_cb callback, void *user_data);
+
+void app_info_unset_batch_event_cb(void);
+
+int app_info_get_cache_stats(unsigned int *hits, unsigned int *misses);
+
+void app_info_get_pool_stats(app_manager_handle_pool_stats_s *stats);
+
 #ifdef __cplusplus
 }
 #endif
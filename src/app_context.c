@@ -20,6 +20,8 @@
 #include <string.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
 
 #include <glib.h>
 
@@ -40,13 +42,18 @@
 
 static int app_context_create(const char *app_id, pid_t pid, app_context_h *app_context);
 
-static int app_context_get_app_context_by_pid(pid_t pid, app_context_h *app_context);
-
+/*
+ * A context never changes once created, so a clone shares it and only bumps the reference
+ * count. The last app_context_destroy() gives it back to the pool.
+ */
 struct app_context_s {
-	char *app_id;
+	volatile int ref_count;
+	const char *app_id; // interned
 	pid_t pid;
 };
 
+static handle_pool_s app_context_pool = HANDLE_POOL_INITIALIZER(struct app_context_s);
+
 typedef struct _foreach_context_ {
 	app_manager_app_context_cb callback;
 	void *user_data;
@@ -59,6 +66,16 @@ typedef struct _retrieval_context_{
 	bool matched;
 } retrieval_context_s;
 
+static bool app_context_lookup_indexed_app_context(const char *app_id, app_context_h *app_context, int *retval);
+
+static bool app_context_lookup_indexed_app_context_by_pid(pid_t pid, app_context_h *app_context, int *retval);
+
+static bool app_context_lookup_indexed_app_id_by_pid(pid_t pid, char **app_id, int *retval);
+
+static bool app_context_is_indexed(const char *app_id, pid_t pid, bool *indexed);
+
+static bool app_context_foreach_indexed_app_context(foreach_context_s *foreach_context);
+
 static int app_context_foreach_app_context_cb(const aul_app_info *aul_app_context, void *cb_data)
 {
 	foreach_context_s* foreach_context = cb_data;
@@ -97,6 +114,11 @@ int app_context_foreach_app_context(app_manager_app_context_cb callback, void *u
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
+	if (app_context_foreach_indexed_app_context(&foreach_context) == true)
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+
 	aul_app_get_running_app_info(app_context_foreach_app_context_cb, &foreach_context);
 
 	return APP_MANAGER_ERROR_NONE;
@@ -119,7 +141,7 @@ static int app_context_retrieve_app_context(const aul_app_info *aul_app_context,
 	return 0;
 }
 
-int app_context_get_app_context(const char *app_id, app_context_h *app_context)
+static int app_context_scan_app_context(const char *app_id, app_context_h *app_context)
 {
 	retrieval_context_s retrieval_context =  {
 		.app_id = app_id,
@@ -127,42 +149,110 @@ int app_context_get_app_context(const char *app_id, app_context_h *app_context)
 		.matched = false
 	};
 
+	// the running list is authoritative, so aul_app_is_running() would only add a round-trip
+	aul_app_get_running_app_info(app_context_retrieve_app_context, &retrieval_context);
+
+	if (retrieval_context.matched == false)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
+	}
+
+	return app_context_create(retrieval_context.app_id, retrieval_context.pid, app_context);
+}
+
+int app_context_get_app_context(const char *app_id, app_context_h *app_context)
+{
+	int retval;
+
 	if (app_id == NULL || app_context == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (aul_app_is_running(app_id) == 0)
+	if (app_context_lookup_indexed_app_context(app_id, app_context, &retval) == true)
 	{
-		return app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
+		return retval;
 	}
 
-	aul_app_get_running_app_info(app_context_retrieve_app_context, &retrieval_context);
+	return app_context_scan_app_context(app_id, app_context);
+}
 
-	if (retrieval_context.matched == false)
+static int app_context_resolve_app_context(pid_t pid, app_context_h *app_context)
+{
+	char appid[APPID_MAX] = {0, };
+
+	if (aul_app_get_pkgname_bypid(pid, appid, sizeof(appid)) != AUL_R_OK)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
 	}
 
-	return app_context_create(retrieval_context.app_id, retrieval_context.pid, app_context);
+	// the context is built from the given pid, which also keeps each instance of a multi-instance application apart
+	return app_context_create(appid, pid, app_context);
 }
 
-static int app_context_get_app_context_by_pid(pid_t pid, app_context_h *app_context)
+int app_context_get_app_id_by_pid(pid_t pid, char **app_id)
 {
-	int retval;
 	char appid[APPID_MAX] = {0, };
+	char *app_id_dup;
+	int retval;
 
-	if (pid < 0 || app_context == NULL)
+	if (app_id == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
+	if (app_context_lookup_indexed_app_id_by_pid(pid, app_id, &retval) == true)
+	{
+		return retval;
+	}
+
 	if (aul_app_get_pkgname_bypid(pid, appid, sizeof(appid)) != AUL_R_OK)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
 	}
 
-	retval = app_context_get_app_context(appid, app_context);
+	app_id_dup = strdup(appid);
+
+	if (app_id_dup == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	*app_id = app_id_dup;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_is_running(const char *app_id, bool *running)
+{
+	if (app_id == NULL || running == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	if (app_context_is_indexed(app_id, 0, running) == false)
+	{
+		*running = aul_app_is_running(app_id);
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_get_app_context_by_pid(pid_t pid, app_context_h *app_context)
+{
+	int retval;
+
+	if (pid <= 0 || app_context == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	if (app_context_lookup_indexed_app_context_by_pid(pid, app_context, &retval) == true)
+	{
+		return retval;
+	}
+
+	retval = app_context_resolve_app_context(pid, app_context);
 
 	if (retval != APP_MANAGER_ERROR_NONE)
 	{
@@ -175,27 +265,29 @@ static int app_context_get_app_context_by_pid(pid_t pid, app_context_h *app_cont
 static int app_context_create(const char *app_id, pid_t pid, app_context_h *app_context)
 {
 	app_context_h app_context_created;
+	const char *interned;
 
 	if (app_id == NULL || pid <= 0 || app_context == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	app_context_created = calloc(1, sizeof(struct app_context_s));
+	interned = app_id_table_intern(app_id);
 
-	if (app_context_created == NULL)
+	if (interned == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
 	}
 
-	app_context_created->app_id = strdup(app_id);
+	app_context_created = handle_pool_take(&app_context_pool);
 
-	if (app_context_created->app_id == NULL)
+	if (app_context_created == NULL)
 	{
-		free(app_context_created);
 		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
 	}
 
+	app_context_created->ref_count = 1;
+	app_context_created->app_id = interned;
 	app_context_created->pid = pid;
 
 	*app_context = app_context_created;
@@ -210,8 +302,10 @@ int app_context_destroy(app_context_h app_context)
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	free(app_context->app_id);
-	free(app_context);
+	if (g_atomic_int_dec_and_test(&(app_context->ref_count)))
+	{
+		handle_pool_release(&app_context_pool, app_context);
+	}
 
 	return APP_MANAGER_ERROR_NONE;
 }
@@ -245,6 +339,25 @@ int app_context_get_app_id(app_context_h app_context, char **app_id)
 }
 
 
+void app_context_get_pool_stats(app_manager_handle_pool_stats_s *stats)
+{
+	handle_pool_get_stats(&app_context_pool, stats);
+}
+
+
+int app_context_get_app_id_peek(app_context_h app_context, const char **app_id)
+{
+	if (app_context == NULL || app_id == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	*app_id = app_context->app_id;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+
 int app_context_get_pid(app_context_h app_context, pid_t *pid)
 {
 	if (app_context == NULL || pid == NULL)
@@ -259,12 +372,18 @@ int app_context_get_pid(app_context_h app_context, pid_t *pid)
 
 int app_context_is_terminated(app_context_h app_context, bool *terminated)
 {
+	bool running;
+
 	if (app_context == NULL || terminated == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (aul_app_is_running(app_context->app_id) == 1)
+	if (app_context_is_indexed(app_context->app_id, app_context->pid, &running) == true)
+	{
+		*terminated = !running;
+	}
+	else if (aul_app_is_running(app_context->app_id) == 1)
 	{
 		*terminated = false;
 	}
@@ -292,7 +411,7 @@ int app_context_is_equal(app_context_h lhs, app_context_h rhs, bool *equal)
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (!strcmp(lhs->app_id, rhs->app_id) && lhs->pid == rhs->pid)
+	if (lhs->app_id == rhs->app_id && lhs->pid == rhs->pid)
 	{
 		*equal = true;
 	}
@@ -306,31 +425,57 @@ int app_context_is_equal(app_context_h lhs, app_context_h rhs, bool *equal)
 
 int app_context_clone(app_context_h *clone, app_context_h app_context)
 {
-	int retval;
-
 	if (clone == NULL || app_context == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	retval = app_context_create(app_context->app_id, app_context->pid, clone);
+	g_atomic_int_inc(&(app_context->ref_count));
 
-	if (retval != APP_MANAGER_ERROR_NONE)
-	{
-		return app_manager_error(retval, __FUNCTION__, NULL);
-	}
+	*clone = app_context;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-typedef struct _event_cb_context_ {
+/*
+ * The live set of running applications is published as an immutable pid table version.
+ * Readers enter one of two epochs and look the version up without locking. Writers are
+ * serialized by event_cb_context_mutex, build a modified copy, publish it and wait for
+ * both epochs to drain before the previous version and the contexts it alone held are freed.
+ */
+typedef struct _pid_table_version_ {
 	GHashTable *pid_table;
+	GHashTable *app_id_table;
+} pid_table_version_s;
+
+struct app_context_subscription_s {
+	volatile int ref_count;
+	volatile int active;
+	char *app_id_prefix;
+	size_t app_id_prefix_len;
+	int events;
 	app_manager_app_context_event_cb callback;
 	void *user_data;
-} event_cb_context_s;
+};
+
+/*
+ * The subscribers are kept in an immutable, reference-counted list that is replaced under
+ * event_cb_context_mutex. An event takes a reference to the current list and dispatches over
+ * it outside of the lock, so subscribing from within a callback does not deadlock.
+ */
+typedef struct _subscription_list_ {
+	volatile int ref_count;
+	int count;
+	app_context_subscription_h subscriptions[];
+} subscription_list_s;
 
 static pthread_mutex_t event_cb_context_mutex = PTHREAD_MUTEX_INITIALIZER;
-static event_cb_context_s *event_cb_context = NULL;
+static subscription_list_s *subscription_list = NULL;
+static app_context_subscription_h legacy_subscription = NULL;
+
+static pid_table_version_s *volatile live_pid_table = NULL;
+static volatile int live_pid_table_epoch = 0;
+static volatile int live_pid_table_readers[2] = { 0, 0 };
 
 static void app_context_lock_event_cb_context()
 {
@@ -342,151 +487,1214 @@ static void app_context_unlock_event_cb_context()
 	pthread_mutex_unlock(&event_cb_context_mutex);
 }
 
-static bool app_context_load_all_app_context_cb_locked(app_context_h app_context, void *user_data)
+static pid_table_version_s *app_context_read_lock_pid_table(int *epoch)
 {
-	app_context_h app_context_cloned;
+	*epoch = g_atomic_int_get(&live_pid_table_epoch);
+	g_atomic_int_inc(&live_pid_table_readers[*epoch]);
 
-	if (app_context_clone(&app_context_cloned, app_context) == APP_MANAGER_ERROR_NONE)
+	return g_atomic_pointer_get(&live_pid_table);
+}
+
+static void app_context_read_unlock_pid_table(int epoch)
+{
+	g_atomic_int_add(&live_pid_table_readers[epoch], -1);
+}
+
+static void app_context_synchronize_pid_table_readers_locked(void)
+{
+	int phase;
+	int epoch;
+
+	// a reader may have sampled the epoch just before a flip, so both epochs are drained
+	for (phase = 0; phase < 2; phase++)
 	{
-		LOGI("[%s] app_id(%s), pid(%d)", __FUNCTION__, app_context->app_id, app_context->pid);
+		epoch = g_atomic_int_get(&live_pid_table_epoch);
+		g_atomic_int_set(&live_pid_table_epoch, !epoch);
 
-		if (event_cb_context != NULL && event_cb_context->pid_table != NULL)
+		while (g_atomic_int_get(&live_pid_table_readers[epoch]) > 0)
 		{
-			g_hash_table_insert(event_cb_context->pid_table, GINT_TO_POINTER(&(app_context_cloned->pid)), app_context_cloned);
+			sched_yield();
 		}
-		else
+	}
+}
+
+static pid_table_version_s *app_context_new_pid_table_version(pid_table_version_s *base)
+{
+	pid_table_version_s *version;
+	GHashTableIter iter;
+	gpointer key;
+	gpointer value;
+
+	version = calloc(1, sizeof(pid_table_version_s));
+
+	if (version == NULL)
+	{
+		return NULL;
+	}
+
+	version->pid_table = g_hash_table_new(g_int_hash, g_int_equal);
+	version->app_id_table = g_hash_table_new(g_str_hash, g_str_equal);
+
+	if (base != NULL)
+	{
+		g_hash_table_iter_init(&iter, base->pid_table);
+
+		while (g_hash_table_iter_next(&iter, &key, &value))
+		{
+			g_hash_table_insert(version->pid_table, key, value);
+		}
+
+		g_hash_table_iter_init(&iter, base->app_id_table);
+
+		while (g_hash_table_iter_next(&iter, &key, &value))
 		{
-			app_context_destroy(app_context_cloned);
-			app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, "invalid callback context");
+			g_hash_table_insert(version->app_id_table, key, value);
 		}
 	}
 
-	return true;
+	return version;
 }
 
-static void app_context_pid_table_entry_destroyed_cb(void * data)
+static void app_context_free_pid_table_version(pid_table_version_s *version)
 {
-	app_context_h app_context = data;
+	if (version != NULL)
+	{
+		g_hash_table_destroy(version->app_id_table);
+		g_hash_table_destroy(version->pid_table);
+		free(version);
+	}
+}
 
-	if (app_context != NULL)
+static void app_context_publish_pid_table_locked(pid_table_version_s *version)
+{
+	pid_table_version_s *retired = live_pid_table;
+
+	g_atomic_pointer_set(&live_pid_table, version);
+
+	app_context_synchronize_pid_table_readers_locked();
+
+	app_context_free_pid_table_version(retired);
+}
+
+static void app_context_index_remove(pid_table_version_s *version, app_context_h app_context)
+{
+	GHashTableIter iter;
+	gpointer value;
+
+	if (g_hash_table_lookup(version->app_id_table, app_context->app_id) == app_context)
 	{
-		char *app_id;
-		int pid;
-		app_context_get_package(app_context, &app_id);
-		app_context_get_pid(app_context, &pid);
-		LOGI("[%s] app_id(%s), pid(%d)", __FUNCTION__, app_context->app_id, app_context->pid);
-		free(app_id);
+		g_hash_table_remove(version->app_id_table, app_context->app_id);
 
-		app_context_destroy(app_context);
+		// another instance of a multi-instance application takes over the entry
+		g_hash_table_iter_init(&iter, version->pid_table);
+
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+		{
+			app_context_h instance = value;
+
+			if (instance != app_context && instance->app_id == app_context->app_id)
+			{
+				g_hash_table_replace(version->app_id_table, (gpointer)instance->app_id, instance);
+				break;
+			}
+		}
 	}
+
+	g_hash_table_remove(version->pid_table, GINT_TO_POINTER(&(app_context->pid)));
 }
 
-static int app_context_launched_event_cb(pid_t pid, void *data)
+static app_context_h app_context_index_insert(pid_table_version_s *version, app_context_h app_context)
 {
-	app_context_h app_context;
+	app_context_h stale;
 
-	app_context_lock_event_cb_context();
+	// the pid was reused without a dead signal
+	stale = g_hash_table_lookup(version->pid_table, GINT_TO_POINTER(&(app_context->pid)));
+
+	if (stale != NULL)
+	{
+		app_context_index_remove(version, stale);
+	}
+
+	g_hash_table_replace(version->pid_table, GINT_TO_POINTER(&(app_context->pid)), app_context);
+	g_hash_table_replace(version->app_id_table, (gpointer)app_context->app_id, app_context);
+
+	return stale;
+}
+
+static bool app_context_lookup_indexed_app_context(const char *app_id, app_context_h *app_context, int *retval)
+{
+	pid_table_version_s *version;
+	app_context_h indexed;
+	int epoch;
+	bool warm = false;
+
+	version = app_context_read_lock_pid_table(&epoch);
 
-	if (app_context_get_app_context_by_pid(pid, &app_context) == APP_MANAGER_ERROR_NONE)
+	// the index is only trusted while the launch/dead signals keep it up to date
+	if (version != NULL)
 	{
-		if (event_cb_context != NULL && event_cb_context->pid_table != NULL)
+		warm = true;
+
+		indexed = g_hash_table_lookup(version->app_id_table, app_id);
+
+		if (indexed != NULL)
 		{
-			g_hash_table_insert(event_cb_context->pid_table, GINT_TO_POINTER(&(app_context->pid)), app_context);
-			event_cb_context->callback(app_context, APP_CONTEXT_EVENT_LAUNCHED, event_cb_context->user_data);
+			*retval = app_context_clone(app_context, indexed);
 		}
 		else
 		{
-			app_context_destroy(app_context);
-			app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, "invalid callback context");
+			*retval = app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
 		}
 	}
 
-	app_context_unlock_event_cb_context();
+	app_context_read_unlock_pid_table(epoch);
 
-	return 0;
+	return warm;
 }
 
-static int app_context_terminated_event_cb(pid_t pid, void *data)
+static bool app_context_lookup_indexed_app_context_by_pid(pid_t pid, app_context_h *app_context, int *retval)
 {
-	app_context_h app_context;
+	pid_table_version_s *version;
+	app_context_h indexed;
 	int lookup_key = pid;
+	int epoch;
+	bool warm = false;
 
-	app_context_lock_event_cb_context();
+	version = app_context_read_lock_pid_table(&epoch);
 
-	if (event_cb_context != NULL && event_cb_context->pid_table != NULL)
+	if (version != NULL)
 	{
-		app_context = g_hash_table_lookup(event_cb_context->pid_table, GINT_TO_POINTER(&lookup_key));
+		warm = true;
 
-		if (app_context != NULL)
+		indexed = g_hash_table_lookup(version->pid_table, GINT_TO_POINTER(&lookup_key));
+
+		if (indexed != NULL)
 		{
-			event_cb_context->callback(app_context, APP_CONTEXT_EVENT_TERMINATED, event_cb_context->user_data);
-			g_hash_table_remove(event_cb_context->pid_table, GINT_TO_POINTER(&(app_context->pid)));
+			*retval = app_context_clone(app_context, indexed);
+		}
+		else
+		{
+			*retval = app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
 		}
 	}
-	else
+
+	app_context_read_unlock_pid_table(epoch);
+
+	return warm;
+}
+
+static bool app_context_lookup_indexed_app_id_by_pid(pid_t pid, char **app_id, int *retval)
+{
+	pid_table_version_s *version;
+	app_context_h indexed;
+	int lookup_key = pid;
+	int epoch;
+	bool warm = false;
+
+	version = app_context_read_lock_pid_table(&epoch);
+
+	if (version != NULL)
 	{
-		app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, "invalid callback context");
+		warm = true;
+
+		indexed = g_hash_table_lookup(version->pid_table, GINT_TO_POINTER(&lookup_key));
+
+		if (indexed != NULL)
+		{
+			*retval = app_context_get_app_id(indexed, app_id);
+		}
+		else
+		{
+			*retval = app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
+		}
 	}
 
-	app_context_unlock_event_cb_context();
+	app_context_read_unlock_pid_table(epoch);
 
-	return 0;
+	return warm;
 }
 
-int app_context_set_event_cb(app_manager_app_context_event_cb callback, void *user_data)
+static bool app_context_is_indexed(const char *app_id, pid_t pid, bool *indexed)
 {
-	if (callback == NULL)
+	pid_table_version_s *version;
+	int lookup_key = pid;
+	int epoch;
+	bool warm = false;
+
+	version = app_context_read_lock_pid_table(&epoch);
+
+	if (version != NULL)
 	{
-		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+		warm = true;
+
+		*indexed = (app_id != NULL && g_hash_table_lookup(version->app_id_table, app_id) != NULL)
+				|| (pid > 0 && g_hash_table_lookup(version->pid_table, GINT_TO_POINTER(&lookup_key)) != NULL);
 	}
 
-	app_context_lock_event_cb_context();
+	app_context_read_unlock_pid_table(epoch);
+
+	return warm;
+}
 
-	if (event_cb_context == NULL)
+static void app_context_subscription_unref(app_context_subscription_h subscription)
+{
+	if (g_atomic_int_dec_and_test(&subscription->ref_count))
 	{
-		event_cb_context = calloc(1, sizeof(event_cb_context_s));
+		free(subscription->app_id_prefix);
+		free(subscription);
+	}
+}
+
+static subscription_list_s *app_context_subscription_list_ref(subscription_list_s *list)
+{
+	g_atomic_int_inc(&list->ref_count);
+
+	return list;
+}
+
+static void app_context_subscription_list_unref(subscription_list_s *list)
+{
+	int i;
 
-		if (event_cb_context == NULL)
+	if (list != NULL && g_atomic_int_dec_and_test(&list->ref_count))
+	{
+		for (i = 0; i < list->count; i++)
 		{
-			return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+			app_context_subscription_unref(list->subscriptions[i]);
 		}
 
-		event_cb_context->pid_table = g_hash_table_new_full(g_int_hash, g_int_equal, NULL, app_context_pid_table_entry_destroyed_cb);
-	
-		if (event_cb_context->pid_table == NULL)
+		free(list);
+	}
+}
+
+// builds the list that follows base with removed left out and added appended, NULL when nobody is left
+static int app_context_new_subscription_list(subscription_list_s *base, app_context_subscription_h added,
+		app_context_subscription_h removed, subscription_list_s **list)
+{
+	subscription_list_s *list_created;
+	int count = (base != NULL ? base->count : 0) + (added != NULL ? 1 : 0);
+	int i;
+
+	list_created = malloc(sizeof(subscription_list_s) + count * sizeof(app_context_subscription_h));
+
+	if (list_created == NULL)
+	{
+		return APP_MANAGER_ERROR_OUT_OF_MEMORY;
+	}
+
+	list_created->ref_count = 1;
+	list_created->count = 0;
+
+	for (i = 0; base != NULL && i < base->count; i++)
+	{
+		if (base->subscriptions[i] != removed)
 		{
-			return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, "failed to initialize pid-table");
+			list_created->subscriptions[list_created->count++] = base->subscriptions[i];
 		}
+	}
 
-		app_context_foreach_app_context(app_context_load_all_app_context_cb_locked, NULL);
+	if (added != NULL)
+	{
+		list_created->subscriptions[list_created->count++] = added;
+	}
 
-		aul_listen_app_dead_signal(app_context_terminated_event_cb, NULL);
-		aul_listen_app_launch_signal(app_context_launched_event_cb, NULL);
+	for (i = 0; i < list_created->count; i++)
+	{
+		g_atomic_int_inc(&list_created->subscriptions[i]->ref_count);
+	}
 
+	if (list_created->count == 0)
+	{
+		free(list_created);
+		list_created = NULL;
 	}
-	
-	event_cb_context->callback = callback;
-	event_cb_context->user_data = user_data;
 
-	app_context_unlock_event_cb_context();
+	*list = list_created;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-void app_context_unset_event_cb(void)
+static bool app_context_subscription_list_has(subscription_list_s *list, app_context_subscription_h subscription)
 {
-	app_context_lock_event_cb_context();
+	int i;
 
-	if (event_cb_context != NULL)
+	for (i = 0; list != NULL && i < list->count; i++)
 	{
-		//aul_listen_app_dead_signal(NULL, NULL);
-		//aul_listen_app_launch_signal(NULL, NULL);
+		if (list->subscriptions[i] == subscription)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool app_context_subscription_matches(app_context_subscription_h subscription, app_context_h app_context, app_context_event_e event)
+{
+	return g_atomic_int_get(&subscription->active)
+			&& (subscription->events & (1 << event))
+			&& strncmp(app_context->app_id, subscription->app_id_prefix, subscription->app_id_prefix_len) == 0;
+}
+
+static bool app_context_subscription_list_matches(subscription_list_s *list, app_context_h app_context, app_context_event_e event)
+{
+	int i;
 
-		g_hash_table_destroy(event_cb_context->pid_table);
-		free(event_cb_context);
-		event_cb_context = NULL;
+	for (i = 0; i < list->count; i++)
+	{
+		if (app_context_subscription_matches(list->subscriptions[i], app_context, event))
+		{
+			return true;
+		}
 	}
 
-	app_context_unlock_event_cb_context();
+	return false;
 }
 
+static void app_context_dispatch_event(subscription_list_s *list, app_context_h app_context, app_context_event_e event)
+{
+	app_context_subscription_h subscription;
+	int i;
+
+	for (i = 0; i < list->count; i++)
+	{
+		subscription = list->subscriptions[i];
+
+		if (app_context_subscription_matches(subscription, app_context, event))
+		{
+			subscription->callback(app_context, event, subscription->user_data);
+		}
+	}
+}
+
+/*
+ * In the asynchronous dispatch mode the signal handlers only update the pid table and push
+ * the event into a bounded single-producer ring, and a dispatcher thread invokes the callbacks.
+ * Producers are serialized by event_cb_context_mutex; the dispatcher never takes it, so slow
+ * callbacks do not hold back signal delivery. A terminate event cancels the pending launch event
+ * of the same pid and both are dropped. The producer forgets the launches the dispatcher has
+ * already taken every APP_CONTEXT_EVENT_QUEUE_SIZE launches, and a terminate forgets its pid in
+ * either mode. Once started, the dispatcher is never stopped: switching back to the synchronous
+ * mode leaves it parked on the empty queue, and it is reused if the asynchronous mode returns.
+ */
+#define APP_CONTEXT_EVENT_QUEUE_SIZE 256
+
+enum {
+	APP_CONTEXT_EVENT_SLOT_PENDING = 1,
+	APP_CONTEXT_EVENT_SLOT_CANCELLED,
+	APP_CONTEXT_EVENT_SLOT_TAKEN,
+};
+
+typedef struct _event_slot_ {
+	volatile int state;
+	unsigned int seq;
+	app_context_event_e event;
+	app_context_h app_context;
+	subscription_list_s *subscriptions;
+} event_slot_s;
+
+typedef struct _event_queue_ {
+	event_slot_s slots[APP_CONTEXT_EVENT_QUEUE_SIZE];
+	volatile unsigned int head;
+	volatile unsigned int tail;
+	sem_t pending;
+	pthread_t dispatcher;
+	bool dispatcher_started;
+	GHashTable *pending_launches;
+	unsigned int launches;
+	volatile unsigned int dispatched;
+	unsigned int coalesced;
+	unsigned int dropped;
+} event_queue_s;
+
+static app_manager_event_dispatch_mode_e event_dispatch_mode = APP_MANAGER_EVENT_DISPATCH_SYNC;
+static event_queue_s event_queue;
+
+static void *app_context_event_dispatcher(void *data)
+{
+	event_slot_s *slot;
+	event_slot_s taken;
+	bool deliver;
+
+	while (true)
+	{
+		if (sem_wait(&event_queue.pending) != 0)
+		{
+			continue;
+		}
+
+		slot = &event_queue.slots[event_queue.head % APP_CONTEXT_EVENT_QUEUE_SIZE];
+
+		deliver = g_atomic_int_compare_and_exchange(&slot->state, APP_CONTEXT_EVENT_SLOT_PENDING, APP_CONTEXT_EVENT_SLOT_TAKEN);
+		taken = *slot;
+
+		// the slot may be reused as soon as the head moves on
+		g_atomic_int_inc((volatile gint *)&event_queue.head);
+
+		// subscribers that left since the event was queued are skipped by the match
+		if (deliver == true)
+		{
+			app_context_dispatch_event(taken.subscriptions, taken.app_context, taken.event);
+			g_atomic_int_inc((volatile gint *)&event_queue.dispatched);
+		}
+
+		app_context_subscription_list_unref(taken.subscriptions);
+		app_context_destroy(taken.app_context);
+	}
+
+	return NULL;
+}
+
+static bool app_context_start_event_dispatcher_locked(void)
+{
+	if (event_queue.dispatcher_started == true)
+	{
+		return true;
+	}
+
+	if (sem_init(&event_queue.pending, 0, 0) != 0)
+	{
+		return false;
+	}
+
+	event_queue.pending_launches = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+	if (pthread_create(&event_queue.dispatcher, NULL, app_context_event_dispatcher, NULL) != 0)
+	{
+		g_hash_table_destroy(event_queue.pending_launches);
+		event_queue.pending_launches = NULL;
+		sem_destroy(&event_queue.pending);
+		return false;
+	}
+
+	pthread_detach(event_queue.dispatcher);
+	event_queue.dispatcher_started = true;
+
+	return true;
+}
+
+// launches up to the head of the queue have been taken by the dispatcher, only dropped ones are still pending
+static void app_context_prune_pending_launches_locked(void)
+{
+	GHashTableIter iter;
+	gpointer value;
+	unsigned int head = g_atomic_int_get((volatile gint *)&event_queue.head);
+
+	g_hash_table_iter_init(&iter, event_queue.pending_launches);
+
+	while (g_hash_table_iter_next(&iter, NULL, &value))
+	{
+		if (GPOINTER_TO_UINT(value) != 0 && (int)(head - GPOINTER_TO_UINT(value)) >= 0)
+		{
+			g_hash_table_iter_remove(&iter);
+		}
+	}
+}
+
+// takes the ownership of app_context in any case
+static void app_context_enqueue_event_locked(app_context_h app_context, app_context_event_e event)
+{
+	event_slot_s *slot;
+	unsigned int seq = event_queue.tail;
+
+	if (seq - g_atomic_int_get((volatile gint *)&event_queue.head) >= APP_CONTEXT_EVENT_QUEUE_SIZE)
+	{
+		// the terminate event of a dropped launch is dropped as well
+		if (event == APP_CONTEXT_EVENT_LAUNCHED)
+		{
+			g_hash_table_insert(event_queue.pending_launches, GINT_TO_POINTER(app_context->pid), GUINT_TO_POINTER(0));
+		}
+
+		event_queue.dropped++;
+		app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, "event queue is full");
+		app_context_destroy(app_context);
+		return;
+	}
+
+	slot = &event_queue.slots[seq % APP_CONTEXT_EVENT_QUEUE_SIZE];
+
+	slot->seq = seq;
+	slot->event = event;
+	slot->app_context = app_context;
+	slot->subscriptions = app_context_subscription_list_ref(subscription_list);
+	g_atomic_int_set(&slot->state, APP_CONTEXT_EVENT_SLOT_PENDING);
+
+	if (event == APP_CONTEXT_EVENT_LAUNCHED)
+	{
+		if (++event_queue.launches % APP_CONTEXT_EVENT_QUEUE_SIZE == 0)
+		{
+			app_context_prune_pending_launches_locked();
+		}
+
+		g_hash_table_insert(event_queue.pending_launches, GINT_TO_POINTER(app_context->pid), GUINT_TO_POINTER(seq + 1));
+	}
+
+	g_atomic_int_set((volatile gint *)&event_queue.tail, seq + 1);
+	sem_post(&event_queue.pending);
+}
+
+// the pending launches map a pid to the sequence number of its launch event plus one, or 0 if it was dropped
+static bool app_context_cancel_pending_launch_locked(pid_t pid)
+{
+	event_slot_s *slot;
+	unsigned int seq;
+	bool cancelled = false;
+
+	seq = GPOINTER_TO_UINT(g_hash_table_lookup(event_queue.pending_launches, GINT_TO_POINTER(pid)));
+
+	if (seq == 0)
+	{
+		if (g_hash_table_remove(event_queue.pending_launches, GINT_TO_POINTER(pid)) == TRUE)
+		{
+			event_queue.dropped++;
+			return true;
+		}
+
+		return false;
+	}
+
+	g_hash_table_remove(event_queue.pending_launches, GINT_TO_POINTER(pid));
+
+	seq--;
+	slot = &event_queue.slots[seq % APP_CONTEXT_EVENT_QUEUE_SIZE];
+
+	// only the producer writes the sequence number, so a reused slot is told apart reliably
+	if (slot->seq == seq)
+	{
+		cancelled = g_atomic_int_compare_and_exchange(&slot->state, APP_CONTEXT_EVENT_SLOT_PENDING, APP_CONTEXT_EVENT_SLOT_CANCELLED);
+	}
+
+	if (cancelled == true)
+	{
+		event_queue.coalesced += 2;
+	}
+
+	return cancelled;
+}
+
+int app_context_set_event_dispatch_mode(app_manager_event_dispatch_mode_e mode)
+{
+	if (mode != APP_MANAGER_EVENT_DISPATCH_SYNC && mode != APP_MANAGER_EVENT_DISPATCH_ASYNC)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	app_context_lock_event_cb_context();
+
+	if (mode == APP_MANAGER_EVENT_DISPATCH_ASYNC && app_context_start_event_dispatcher_locked() == false)
+	{
+		app_context_unlock_event_cb_context();
+		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, "failed to start the event dispatcher");
+	}
+
+	event_dispatch_mode = mode;
+
+	app_context_unlock_event_cb_context();
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_get_event_stats(unsigned int *dispatched, unsigned int *coalesced, unsigned int *dropped)
+{
+	if (dispatched == NULL || coalesced == NULL || dropped == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	app_context_lock_event_cb_context();
+
+	*dispatched = g_atomic_int_get((volatile gint *)&event_queue.dispatched);
+	*coalesced = event_queue.coalesced;
+	*dropped = event_queue.dropped;
+
+	app_context_unlock_event_cb_context();
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static bool app_context_load_all_app_context_cb(app_context_h app_context, void *user_data)
+{
+	pid_table_version_s *version = user_data;
+	app_context_h app_context_cloned;
+	app_context_h stale;
+
+	if (app_context_clone(&app_context_cloned, app_context) == APP_MANAGER_ERROR_NONE)
+	{
+		LOGI("[%s] app_id(%s), pid(%d)", __FUNCTION__, app_context->app_id, app_context->pid);
+
+		stale = app_context_index_insert(version, app_context_cloned);
+
+		if (stale != NULL)
+		{
+			app_context_destroy(stale);
+		}
+	}
+
+	return true;
+}
+
+static void app_context_pid_table_entry_destroyed_cb(void * data)
+{
+	app_context_h app_context = data;
+
+	if (app_context != NULL)
+	{
+		LOGI("[%s] app_id(%s), pid(%d)", __FUNCTION__, app_context->app_id, app_context->pid);
+
+		app_context_destroy(app_context);
+	}
+}
+
+static int app_context_launched_event_cb(pid_t pid, void *data)
+{
+	pid_table_version_s *version;
+	app_context_h app_context;
+	app_context_h app_context_event = NULL;
+	app_context_h stale = NULL;
+	subscription_list_s *subscriptions = NULL;
+
+	// the pid is not indexed yet, so it is resolved with a single round-trip outside of the lock
+	if (app_context_resolve_app_context(pid, &app_context) != APP_MANAGER_ERROR_NONE)
+	{
+		return 0;
+	}
+
+	app_context_lock_event_cb_context();
+
+	if (subscription_list != NULL && live_pid_table != NULL)
+	{
+		version = app_context_new_pid_table_version(live_pid_table);
+
+		if (version != NULL)
+		{
+			stale = app_context_index_insert(version, app_context);
+			app_context_publish_pid_table_locked(version);
+
+			// the filters are checked first, so nothing is copied or queued for an event nobody wants
+			if (app_context_subscription_list_matches(subscription_list, app_context, APP_CONTEXT_EVENT_LAUNCHED) == true)
+			{
+				if (app_context_clone(&app_context_event, app_context) != APP_MANAGER_ERROR_NONE)
+				{
+					app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+				}
+				else if (event_dispatch_mode == APP_MANAGER_EVENT_DISPATCH_ASYNC)
+				{
+					app_context_enqueue_event_locked(app_context_event, APP_CONTEXT_EVENT_LAUNCHED);
+					app_context_event = NULL;
+				}
+				else
+				{
+					subscriptions = app_context_subscription_list_ref(subscription_list);
+				}
+			}
+		}
+		else
+		{
+			app_context_destroy(app_context);
+			app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+		}
+	}
+	else
+	{
+		app_context_destroy(app_context);
+		app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, "invalid callback context");
+	}
+
+	app_context_unlock_event_cb_context();
+
+	app_context_pid_table_entry_destroyed_cb(stale);
+
+	// the callbacks get their own copy, so they run outside of the lock without racing the pid table
+	if (app_context_event != NULL)
+	{
+		app_context_dispatch_event(subscriptions, app_context_event, APP_CONTEXT_EVENT_LAUNCHED);
+		app_context_subscription_list_unref(subscriptions);
+		app_context_destroy(app_context_event);
+	}
+
+	return 0;
+}
+
+static int app_context_terminated_event_cb(pid_t pid, void *data)
+{
+	pid_table_version_s *version;
+	app_context_h app_context = NULL;
+	subscription_list_s *subscriptions = NULL;
+	bool coalesced;
+	int lookup_key = pid;
+
+	app_context_lock_event_cb_context();
+
+	if (subscription_list != NULL && live_pid_table != NULL)
+	{
+		app_context = g_hash_table_lookup(live_pid_table->pid_table, GINT_TO_POINTER(&lookup_key));
+
+		if (app_context != NULL)
+		{
+			version = app_context_new_pid_table_version(live_pid_table);
+
+			if (version != NULL)
+			{
+				app_context_index_remove(version, app_context);
+				app_context_publish_pid_table_locked(version);
+
+				// a pid reused after a mode switch must not inherit the pending launch of its predecessor
+				coalesced = event_queue.dispatcher_started == true && app_context_cancel_pending_launch_locked(pid) == true;
+
+				if (coalesced == false && app_context_subscription_list_matches(subscription_list, app_context, APP_CONTEXT_EVENT_TERMINATED) == true)
+				{
+					if (event_dispatch_mode == APP_MANAGER_EVENT_DISPATCH_ASYNC)
+					{
+						app_context_enqueue_event_locked(app_context, APP_CONTEXT_EVENT_TERMINATED);
+						app_context = NULL;
+					}
+					else
+					{
+						subscriptions = app_context_subscription_list_ref(subscription_list);
+					}
+				}
+			}
+			else
+			{
+				app_context = NULL;
+				app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+			}
+		}
+	}
+	else
+	{
+		app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, "invalid callback context");
+	}
+
+	app_context_unlock_event_cb_context();
+
+	// no reader can reach the removed context any more, so it is handed to the callback as it is
+	if (app_context != NULL)
+	{
+		if (subscriptions != NULL)
+		{
+			app_context_dispatch_event(subscriptions, app_context, APP_CONTEXT_EVENT_TERMINATED);
+			app_context_subscription_list_unref(subscriptions);
+		}
+
+		app_context_pid_table_entry_destroyed_cb(app_context);
+	}
+
+	return 0;
+}
+
+static int app_context_start_pid_table_locked(void)
+{
+	pid_table_version_s *version;
+
+	version = app_context_new_pid_table_version(NULL);
+
+	if (version == NULL)
+	{
+		return APP_MANAGER_ERROR_IO_ERROR;
+	}
+
+	app_context_foreach_app_context(app_context_load_all_app_context_cb, version);
+
+	app_context_publish_pid_table_locked(version);
+
+	aul_listen_app_dead_signal(app_context_terminated_event_cb, NULL);
+	aul_listen_app_launch_signal(app_context_launched_event_cb, NULL);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static void app_context_stop_pid_table_locked(void)
+{
+	pid_table_version_s *version;
+	GHashTableIter iter;
+	gpointer value;
+
+	//aul_listen_app_dead_signal(NULL, NULL);
+	//aul_listen_app_launch_signal(NULL, NULL);
+
+	version = live_pid_table;
+
+	g_atomic_pointer_set(&live_pid_table, NULL);
+	app_context_synchronize_pid_table_readers_locked();
+
+	if (version != NULL)
+	{
+		g_hash_table_iter_init(&iter, version->pid_table);
+
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+		{
+			app_context_pid_table_entry_destroyed_cb(value);
+		}
+
+		app_context_free_pid_table_version(version);
+	}
+
+	if (event_queue.dispatcher_started == true)
+	{
+		g_hash_table_remove_all(event_queue.pending_launches);
+	}
+}
+
+// the pid table and the signal listeners live as long as there is at least one subscriber
+static int app_context_update_subscriptions_locked(app_context_subscription_h added, app_context_subscription_h removed)
+{
+	subscription_list_s *list;
+	int retval;
+
+	retval = app_context_new_subscription_list(subscription_list, added, removed, &list);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return retval;
+	}
+
+	if (list != NULL && live_pid_table == NULL)
+	{
+		retval = app_context_start_pid_table_locked();
+
+		if (retval != APP_MANAGER_ERROR_NONE)
+		{
+			app_context_subscription_list_unref(list);
+			return retval;
+		}
+	}
+
+	// events already on their way to the removed subscriber are not delivered any more
+	if (removed != NULL)
+	{
+		g_atomic_int_set(&removed->active, 0);
+	}
+
+	app_context_subscription_list_unref(subscription_list);
+	subscription_list = list;
+
+	if (list == NULL && live_pid_table != NULL)
+	{
+		app_context_stop_pid_table_locked();
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static int app_context_create_subscription(const char *app_id_prefix, int events,
+		app_manager_app_context_event_cb callback, void *user_data, app_context_subscription_h *subscription)
+{
+	app_context_subscription_h subscription_created;
+
+	subscription_created = calloc(1, sizeof(struct app_context_subscription_s));
+
+	if (subscription_created == NULL)
+	{
+		return APP_MANAGER_ERROR_OUT_OF_MEMORY;
+	}
+
+	subscription_created->app_id_prefix = strdup(app_id_prefix != NULL ? app_id_prefix : "");
+
+	if (subscription_created->app_id_prefix == NULL)
+	{
+		free(subscription_created);
+		return APP_MANAGER_ERROR_OUT_OF_MEMORY;
+	}
+
+	subscription_created->ref_count = 1;
+	subscription_created->active = 1;
+	subscription_created->app_id_prefix_len = strlen(subscription_created->app_id_prefix);
+	subscription_created->events = events;
+	subscription_created->callback = callback;
+	subscription_created->user_data = user_data;
+
+	*subscription = subscription_created;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_subscribe_event(const char *app_id_prefix, int events,
+		app_manager_app_context_event_cb callback, void *user_data, app_context_subscription_h *subscription)
+{
+	app_context_subscription_h subscription_created;
+	int retval;
+
+	if (callback == NULL || subscription == NULL || events == 0 || (events & ~APP_MANAGER_EVENT_MASK_ALL) != 0)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_context_create_subscription(app_id_prefix, events, callback, user_data, &subscription_created);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	app_context_lock_event_cb_context();
+
+	retval = app_context_update_subscriptions_locked(subscription_created, NULL);
+
+	app_context_unlock_event_cb_context();
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		app_context_subscription_unref(subscription_created);
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	*subscription = subscription_created;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_unsubscribe_event(app_context_subscription_h subscription)
+{
+	int retval;
+
+	if (subscription == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	app_context_lock_event_cb_context();
+
+	if (subscription == legacy_subscription || app_context_subscription_list_has(subscription_list, subscription) == false)
+	{
+		app_context_unlock_event_cb_context();
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, "not subscribed");
+	}
+
+	retval = app_context_update_subscriptions_locked(NULL, subscription);
+
+	app_context_unlock_event_cb_context();
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	app_context_subscription_unref(subscription);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_set_event_cb(app_manager_app_context_event_cb callback, void *user_data)
+{
+	app_context_subscription_h subscription;
+	int retval;
+
+	if (callback == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_context_create_subscription(NULL, APP_MANAGER_EVENT_MASK_ALL, callback, user_data, &subscription);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	app_context_lock_event_cb_context();
+
+	// the callback registered through this function replaces the previous one in place
+	retval = app_context_update_subscriptions_locked(subscription, legacy_subscription);
+
+	if (retval == APP_MANAGER_ERROR_NONE)
+	{
+		if (legacy_subscription != NULL)
+		{
+			app_context_subscription_unref(legacy_subscription);
+		}
+
+		legacy_subscription = subscription;
+	}
+
+	app_context_unlock_event_cb_context();
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		app_context_subscription_unref(subscription);
+		return app_manager_error(retval, __FUNCTION__, "failed to initialize pid-table");
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+void app_context_unset_event_cb(void)
+{
+	app_context_lock_event_cb_context();
+
+	if (legacy_subscription != NULL && app_context_update_subscriptions_locked(NULL, legacy_subscription) == APP_MANAGER_ERROR_NONE)
+	{
+		app_context_subscription_unref(legacy_subscription);
+		legacy_subscription = NULL;
+	}
+
+	app_context_unlock_event_cb_context();
+}
+
+
+struct app_context_snapshot_s {
+	int count;
+	app_context_record_s records[];
+};
+
+typedef struct _snapshot_context_ {
+	GArray *pids;
+	GString *app_ids;
+} snapshot_context_s;
+
+static void app_context_snapshot_add(snapshot_context_s *snapshot_context, pid_t pid, const char *app_id)
+{
+	g_array_append_val(snapshot_context->pids, pid);
+	g_string_append_len(snapshot_context->app_ids, app_id, strlen(app_id) + 1);
+}
+
+static int app_context_snapshot_collect_cb(const aul_app_info *aul_app_context, void *cb_data)
+{
+	snapshot_context_s *snapshot_context = cb_data;
+
+	if (aul_app_context != NULL && aul_app_context->pkg_name != NULL && snapshot_context != NULL)
+	{
+		app_context_snapshot_add(snapshot_context, aul_app_context->pid, aul_app_context->pkg_name);
+	}
+
+	return 0;
+}
+
+static bool app_context_snapshot_collect_indexed(snapshot_context_s *snapshot_context)
+{
+	pid_table_version_s *version;
+	GHashTableIter iter;
+	gpointer value;
+	int epoch;
+	bool warm = false;
+
+	version = app_context_read_lock_pid_table(&epoch);
+
+	if (version != NULL)
+	{
+		warm = true;
+
+		g_hash_table_iter_init(&iter, version->pid_table);
+
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+		{
+			app_context_h app_context = value;
+
+			app_context_snapshot_add(snapshot_context, app_context->pid, app_context->app_id);
+		}
+	}
+
+	app_context_read_unlock_pid_table(epoch);
+
+	return warm;
+}
+
+static bool app_context_foreach_indexed_app_context(foreach_context_s *foreach_context)
+{
+	snapshot_context_s snapshot_context;
+	app_context_h app_context;
+	const char *app_id;
+	unsigned int i;
+	bool warm;
+
+	snapshot_context.pids = g_array_new(FALSE, FALSE, sizeof(pid_t));
+	snapshot_context.app_ids = g_string_new(NULL);
+
+	// the callbacks may be slow or call back into this module, so they run over a copy outside of the read section
+	warm = app_context_snapshot_collect_indexed(&snapshot_context);
+
+	app_id = snapshot_context.app_ids->str;
+
+	for (i = 0; warm == true && i < snapshot_context.pids->len && foreach_context->iteration == true; i++)
+	{
+		if (app_context_create(app_id, g_array_index(snapshot_context.pids, pid_t, i), &app_context) == APP_MANAGER_ERROR_NONE)
+		{
+			foreach_context->iteration = foreach_context->callback(app_context, foreach_context->user_data);
+			app_context_destroy(app_context);
+		}
+
+		app_id += strlen(app_id) + 1;
+	}
+
+	g_array_free(snapshot_context.pids, TRUE);
+	g_string_free(snapshot_context.app_ids, TRUE);
+
+	return warm;
+}
+
+int app_context_get_snapshot(app_context_snapshot_h *snapshot)
+{
+	snapshot_context_s snapshot_context;
+	app_context_snapshot_h snapshot_created;
+	char *app_ids;
+	int i;
+
+	if (snapshot == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	snapshot_context.pids = g_array_new(FALSE, FALSE, sizeof(pid_t));
+	snapshot_context.app_ids = g_string_new(NULL);
+
+	if (app_context_snapshot_collect_indexed(&snapshot_context) == false)
+	{
+		aul_app_get_running_app_info(app_context_snapshot_collect_cb, &snapshot_context);
+	}
+
+	// a single block holds the header, the records and the strings the records point into
+	snapshot_created = malloc(sizeof(struct app_context_snapshot_s)
+			+ snapshot_context.pids->len * sizeof(app_context_record_s)
+			+ snapshot_context.app_ids->len);
+
+	if (snapshot_created == NULL)
+	{
+		g_array_free(snapshot_context.pids, TRUE);
+		g_string_free(snapshot_context.app_ids, TRUE);
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	snapshot_created->count = snapshot_context.pids->len;
+
+	app_ids = (char *)&(snapshot_created->records[snapshot_created->count]);
+	memcpy(app_ids, snapshot_context.app_ids->str, snapshot_context.app_ids->len);
+
+	for (i = 0; i < snapshot_created->count; i++)
+	{
+		snapshot_created->records[i].pid = g_array_index(snapshot_context.pids, pid_t, i);
+		snapshot_created->records[i].app_id = app_ids;
+		app_ids += strlen(app_ids) + 1;
+	}
+
+	g_array_free(snapshot_context.pids, TRUE);
+	g_string_free(snapshot_context.app_ids, TRUE);
+
+	*snapshot = snapshot_created;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_snapshot_get_records(app_context_snapshot_h snapshot, const app_context_record_s **records, int *count)
+{
+	if (snapshot == NULL || records == NULL || count == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	*records = snapshot->records;
+	*count = snapshot->count;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_context_snapshot_destroy(app_context_snapshot_h snapshot)
+{
+	if (snapshot == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	free(snapshot);
+
+	return APP_MANAGER_ERROR_NONE;
+}
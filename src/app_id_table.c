@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <glib.h>
+
+#include <app_manager.h>
+#include <app_manager_private.h>
+
+/*
+ * Every application ID held by a handle, a cached row or an event is interned here, so each
+ * one is stored once and two interned IDs are equal exactly when they are the same pointer.
+ * The IDs are kept for the lifetime of the process, which spares every enumeration a round of
+ * allocations for the IDs nobody else holds. To keep them bounded by the applications seen
+ * meanwhile, an ID is only interned once AIL, AUL, the index or the package manager has
+ * reported it, never straight from the caller.
+ */
+static pthread_rwlock_t app_id_table_lock = PTHREAD_RWLOCK_INITIALIZER;
+static GHashTable *app_id_table = NULL;
+
+const char *app_id_table_intern(const char *app_id)
+{
+	char *interned = NULL;
+
+	if (app_id == NULL)
+	{
+		return NULL;
+	}
+
+	pthread_rwlock_rdlock(&app_id_table_lock);
+
+	if (app_id_table != NULL)
+	{
+		interned = g_hash_table_lookup(app_id_table, app_id);
+	}
+
+	pthread_rwlock_unlock(&app_id_table_lock);
+
+	if (interned != NULL)
+	{
+		return interned;
+	}
+
+	pthread_rwlock_wrlock(&app_id_table_lock);
+
+	if (app_id_table == NULL)
+	{
+		app_id_table = g_hash_table_new(g_str_hash, g_str_equal);
+	}
+
+	// another thread may have interned it in the meantime
+	interned = g_hash_table_lookup(app_id_table, app_id);
+
+	if (interned == NULL)
+	{
+		interned = strdup(app_id);
+
+		if (interned != NULL)
+		{
+			g_hash_table_insert(app_id_table, interned, interned);
+		}
+	}
+
+	pthread_rwlock_unlock(&app_id_table_lock);
+
+	return interned;
+}
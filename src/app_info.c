@@ -19,9 +19,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <pthread.h>
+
+#include <glib.h>
 
 #include <ail.h>
-#include <package-manager.h>
 #include <dlog.h>
 
 #include <app_info.h>
@@ -34,24 +36,84 @@
 
 #define LOG_TAG "TIZEN_N_APP_MANAGER"
 
+#define APP_INFO_CACHE_SIZE 64
+
 static int app_info_create(const char *app_id, app_info_h *app_info);
 
-struct app_info_s {
-	char *app_id;
+static int app_info_create_borrowed(ail_appinfo_h ail_app_info, app_info_h *app_info);
+static int app_info_get_ail_app_info(app_info_h app_info, ail_appinfo_h *ail_app_info);
+static const char *app_info_table_column_property(int column);
+
+static int app_info_start_package_event_listener(void);
+
+typedef struct _app_info_row_ {
 	ail_appinfo_h ail_app_info;
+	const char *app_id; // interned
+	volatile int ref_count;
+} app_info_row_s;
+
+static void app_info_row_unref(app_info_row_s *row);
+static int app_info_cache_get_row(const char *app_id, app_info_row_s **row);
+
+/*
+ * A handle is created with its app_id only and loads its row on the first getter that needs
+ * the metadata, so handing out a handle does not touch the database. The row never changes
+ * once loaded, so a clone shares the handle and only bumps the reference count. A handle
+ * borrowed from a listing uses the listed row instead and has no reference count, since AIL
+ * frees that row when the callback returns; its clone is a handle of its own.
+ *
+ * A handle found in the metadata index, by a lookup or while listing it, holds the index mapping
+ * instead and serves the name, icon and version from its entry without loading the row at all.
+ */
+struct app_info_s {
+	volatile int ref_count;
+	const char *app_id; // interned
+	ail_appinfo_h borrowed_ail_app_info;
+	app_info_row_s *volatile row;
+	app_info_index_s *index;
+	const app_info_index_entry_s *index_entry;
 };
 
+typedef struct _app_info_cache_ {
+	GHashTable *row_table;
+	GQueue lru;
+	unsigned int generation;
+	unsigned int hits;
+	unsigned int misses;
+} app_info_cache_s;
+
+static handle_pool_s app_info_pool = HANDLE_POOL_INITIALIZER(struct app_info_s);
+
+static pthread_mutex_t app_info_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static app_info_cache_s app_info_cache;
+
 typedef struct _foreach_context_{
 	app_manager_app_info_cb callback;
 	void *user_data;
+	int skip;
+	int remaining;
 } foreach_context_s;
 
+/*
+ * The predicates of a filter are handed to AIL as they are added, so the database only
+ * returns the matching rows. AIL has no notion of ordering or paging: the rows are listed
+ * in the order of the database, the offset is skipped before a handle is made for a row and
+ * the listing is cancelled as soon as the limit is reached.
+ */
+struct app_info_filter_s {
+	ail_filter_h ail_filter;
+	int offset;
+	int limit;
+	int index_mask;
+	int index_flags;
+	bool index_usable; // only the boolean predicates can be matched against the index
+};
+
 
 static ail_cb_ret_e app_info_foreach_app_info_cb(const ail_appinfo_h ail_app_info, void *cb_data)
 {
 	foreach_context_s *foreach_context = cb_data;
 	app_info_h app_info = NULL;
-	char *app_id;
 	bool iteration_next = true;
 
 	if (ail_app_info == NULL || foreach_context == NULL)
@@ -60,15 +122,25 @@ static ail_cb_ret_e app_info_foreach_app_info_cb(const ail_appinfo_h ail_app_inf
 		return AIL_CB_RET_CANCEL;
 	}
 
-	ail_appinfo_get_str(ail_app_info, AIL_PROP_PACKAGE_STR, &app_id);
+	if (foreach_context->skip > 0)
+	{
+		foreach_context->skip--;
+		return AIL_CB_RET_CONTINUE;
+	}
+
+	if (foreach_context->remaining > 0)
+	{
+		foreach_context->remaining--;
+	}
 
-	if (app_info_create(app_id, &app_info) == APP_MANAGER_ERROR_NONE)
+	// the row is already loaded, querying it again by its app_id would double the database work
+	if (app_info_create_borrowed(ail_app_info, &app_info) == APP_MANAGER_ERROR_NONE)
 	{
 		iteration_next = foreach_context->callback(app_info, foreach_context->user_data);
 		app_info_destroy(app_info);
 	}
 
-	if (iteration_next == true)
+	if (iteration_next == true && foreach_context->remaining != 0)
 	{
 		return AIL_CB_RET_CONTINUE;
 	}
@@ -78,318 +150,1779 @@ static ail_cb_ret_e app_info_foreach_app_info_cb(const ail_appinfo_h ail_app_inf
 	}
 }
 
+static int app_info_create_indexed(app_info_index_s *index, const app_info_index_entry_s *entry, app_info_h *app_info)
+{
+	app_info_h app_info_created;
+	const char *interned;
+
+	interned = app_id_table_intern(app_info_index_get_app_id(index, entry));
+
+	if (interned == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	app_info_created = handle_pool_take(&app_info_pool);
+
+	if (app_info_created == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	app_info_created->ref_count = 1;
+	app_info_created->app_id = interned;
+	app_info_created->index = app_info_index_ref(index);
+	app_info_created->index_entry = entry;
+
+	*app_info = app_info_created;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+// the entries are in the order AIL lists the applications, so the pages match those of a listing
+static void app_info_foreach_indexed(app_info_index_s *index, int mask, int flags, foreach_context_s *foreach_context)
+{
+	const app_info_index_entry_s *entry;
+	app_info_h app_info = NULL;
+	bool iteration_next = true;
+	int count;
+	int i;
+
+	count = app_info_index_get_count(index);
+
+	for (i = 0; i < count && iteration_next == true && foreach_context->remaining != 0; i++)
+	{
+		entry = app_info_index_get_entry(index, i);
+
+		if ((app_info_index_get_flags(entry) & mask) != flags)
+		{
+			continue;
+		}
+
+		if (foreach_context->skip > 0)
+		{
+			foreach_context->skip--;
+			continue;
+		}
+
+		if (foreach_context->remaining > 0)
+		{
+			foreach_context->remaining--;
+		}
+
+		if (app_info_create_indexed(index, entry, &app_info) == APP_MANAGER_ERROR_NONE)
+		{
+			iteration_next = foreach_context->callback(app_info, foreach_context->user_data);
+			app_info_destroy(app_info);
+		}
+	}
+}
+
+static int app_info_count_indexed(app_info_index_s *index, int mask, int flags)
+{
+	int matched = 0;
+	int count;
+	int i;
+
+	count = app_info_index_get_count(index);
+
+	for (i = 0; i < count; i++)
+	{
+		if ((app_info_index_get_flags(app_info_index_get_entry(index, i)) & mask) == flags)
+		{
+			matched++;
+		}
+	}
+
+	return matched;
+}
+
 int app_info_foreach_app_info(app_manager_app_info_cb callback, void *user_data)
 {
 	foreach_context_s foreach_context = {
 		.callback = callback,
 		.user_data = user_data,
+		.skip = 0,
+		.remaining = -1,
 	};
+	app_info_index_s *index;
 
 	if (callback == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
+	index = app_info_index_acquire();
+
+	if (index != NULL)
+	{
+		app_info_foreach_indexed(index, 0, 0, &foreach_context);
+		app_info_index_release(index);
+		return APP_MANAGER_ERROR_NONE;
+	}
+
 	ail_filter_list_appinfo_foreach(NULL, app_info_foreach_app_info_cb, &foreach_context);
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-int app_info_get_app_info(const char *app_id, app_info_h *app_info)
-{
-	return app_info_create(app_id, app_info);
-}
-
-static int app_info_create(const char *app_id, app_info_h *app_info)
+int app_info_foreach_app_info_by_filter(app_info_filter_h filter, app_manager_app_info_cb callback, void *user_data)
 {
-	app_info_h app_info_created;
-	ail_appinfo_h ail_app_info;
+	foreach_context_s foreach_context = {
+		.callback = callback,
+		.user_data = user_data,
+	};
+	app_info_index_s *index = NULL;
 
-	if (app_id == NULL || app_info == NULL)
+	if (filter == NULL || callback == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (ail_package_get_appinfo(app_id, &ail_app_info) != AIL_ERROR_OK)
+	foreach_context.skip = filter->offset;
+	foreach_context.remaining = filter->limit;
+
+	if (foreach_context.remaining == 0)
 	{
-		return app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
+		return APP_MANAGER_ERROR_NONE;
 	}
 
-	app_info_created = calloc(1, sizeof(struct app_info_s));
-
-	if (app_info_created == NULL)
+	if (filter->index_usable == true)
 	{
-		ail_package_destroy_appinfo(ail_app_info);
-		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+		index = app_info_index_acquire();
 	}
 
-	app_info_created->app_id = strdup(app_id);
-
-	if (app_info_created->app_id == NULL)
+	if (index != NULL)
 	{
-		ail_package_destroy_appinfo(ail_app_info);
-		free(app_info_created);
-		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+		app_info_foreach_indexed(index, filter->index_mask, filter->index_flags, &foreach_context);
+		app_info_index_release(index);
+		return APP_MANAGER_ERROR_NONE;
 	}
 
-	app_info_created->ail_app_info = ail_app_info;
-
-	*app_info = app_info_created;
+	if (ail_filter_list_appinfo_foreach(filter->ail_filter, app_info_foreach_app_info_cb, &foreach_context) != AIL_ERROR_OK)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_DB_FAILED, __FUNCTION__, NULL);
+	}
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-int app_info_destroy(app_info_h app_info)
+int app_info_count_app_info_by_filter(app_info_filter_h filter, int *count)
 {
-	if (app_info == NULL)
+	app_info_index_s *index = NULL;
+	int matched;
+
+	if (filter == NULL || count == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	free(app_info->app_id);
+	if (filter->index_usable == true)
+	{
+		index = app_info_index_acquire();
+	}
+
+	if (index != NULL)
+	{
+		matched = app_info_count_indexed(index, filter->index_mask, filter->index_flags);
+		app_info_index_release(index);
+	}
+	else if (ail_filter_count_appinfo(filter->ail_filter, &matched) != AIL_ERROR_OK)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_DB_FAILED, __FUNCTION__, NULL);
+	}
+
+	// the count is that of the page the filter selects
+	matched = matched > filter->offset ? matched - filter->offset : 0;
 
-	ail_package_destroy_appinfo(app_info->ail_app_info);
+	if (filter->limit >= 0 && matched > filter->limit)
+	{
+		matched = filter->limit;
+	}
 
-	free(app_info);	
+	*count = matched;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-int app_info_get_app_id(app_info_h app_info, char **app_id)
+int app_info_filter_create(app_info_filter_h *filter)
 {
-	char *app_id_dup;
+	app_info_filter_h filter_created;
 
-	if (app_info == NULL || app_id == NULL)
+	if (filter == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	app_id_dup = strdup(app_info->app_id);
+	filter_created = calloc(1, sizeof(struct app_info_filter_s));
 
-	if (app_id_dup == NULL)
+	if (filter_created == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
 	}
 
-	*app_id = app_id_dup;
+	if (ail_filter_new(&(filter_created->ail_filter)) != AIL_ERROR_OK)
+	{
+		free(filter_created);
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	filter_created->offset = 0;
+	filter_created->limit = -1;
+	filter_created->index_mask = 0;
+	filter_created->index_flags = 0;
+	filter_created->index_usable = true;
+
+	*filter = filter_created;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-
-int app_info_get_name(app_info_h app_info, char **name)
+int app_info_filter_destroy(app_info_filter_h filter)
 {
-	char *ail_value = NULL;
-	char *name_dup;
-
-	if (app_info == NULL || name == NULL)
+	if (filter == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (ail_appinfo_get_str(app_info->ail_app_info, AIL_PROP_NAME_STR, &ail_value) != AIL_ERROR_OK)
-	{
-		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
-	}
+	ail_filter_destroy(filter->ail_filter);
+	free(filter);
 
-	name_dup = strdup(ail_value);
+	return APP_MANAGER_ERROR_NONE;
+}
 
-	if (name_dup == NULL)
+static const char *app_info_filter_get_ail_property(app_info_filter_property_e property, bool *is_bool)
+{
+	switch (property)
 	{
-		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
-	}
+	case APP_INFO_FILTER_PROPERTY_TYPE:
+		*is_bool = false;
+		return AIL_PROP_TYPE_STR;
 
-	*name = name_dup;
+	case APP_INFO_FILTER_PROPERTY_PACKAGE_TYPE:
+		*is_bool = false;
+		return AIL_PROP_X_SLP_PACKAGETYPE_STR;
 
-	return APP_MANAGER_ERROR_NONE;
+	case APP_INFO_FILTER_PROPERTY_NODISPLAY:
+		*is_bool = true;
+		return AIL_PROP_NODISPLAY_BOOL;
+
+	case APP_INFO_FILTER_PROPERTY_TASKMANAGE:
+		*is_bool = true;
+		return AIL_PROP_X_SLP_TASKMANAGE_BOOL;
+
+	case APP_INFO_FILTER_PROPERTY_REMOVABLE:
+		*is_bool = true;
+		return AIL_PROP_X_SLP_REMOVABLE_BOOL;
+
+	default:
+		return NULL;
+	}
 }
 
+static int app_info_filter_get_index_flag(app_info_filter_property_e property)
+{
+	switch (property)
+	{
+	case APP_INFO_FILTER_PROPERTY_NODISPLAY:
+		return APP_INFO_INDEX_FLAG_NODISPLAY;
+
+	case APP_INFO_FILTER_PROPERTY_TASKMANAGE:
+		return APP_INFO_INDEX_FLAG_TASKMANAGE;
 
-int app_info_get_version(app_info_h app_info, char **version)
+	case APP_INFO_FILTER_PROPERTY_REMOVABLE:
+		return APP_INFO_INDEX_FLAG_REMOVABLE;
+
+	default:
+		return 0;
+	}
+}
+
+int app_info_filter_add_bool(app_info_filter_h filter, app_info_filter_property_e property, bool value)
 {
-	char *ail_value = NULL;
-	char *version_dup;
+	const char *ail_property;
+	bool is_bool = false;
+	int index_flag;
 
-	if (app_info == NULL || version == NULL)
+	if (filter == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (ail_appinfo_get_str(app_info->ail_app_info, AIL_PROP_VERSION_STR, &ail_value) != AIL_ERROR_OK)
+	ail_property = app_info_filter_get_ail_property(property, &is_bool);
+
+	if (ail_property == NULL || is_bool == false)
 	{
-		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, "not a boolean property");
 	}
 
-	version_dup = strdup(ail_value);
-
-	if (version_dup == NULL)
+	if (ail_filter_add_bool(filter->ail_filter, ail_property, value) != AIL_ERROR_OK)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
 	}
 
-	*version = version_dup;
+	index_flag = app_info_filter_get_index_flag(property);
+
+	// contradicting predicates are left for AIL to sort out
+	if ((filter->index_mask & index_flag) && ((filter->index_flags & index_flag) != 0) != value)
+	{
+		filter->index_usable = false;
+	}
+
+	filter->index_mask |= index_flag;
+	filter->index_flags = value ? filter->index_flags | index_flag : filter->index_flags & ~index_flag;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-
-int app_info_get_icon(app_info_h app_info, char **path)
+int app_info_filter_add_string(app_info_filter_h filter, app_info_filter_property_e property, const char *value)
 {
-	char *ail_value = NULL;
-	char *path_dup;
+	const char *ail_property;
+	bool is_bool = true;
 
-	if (app_info == NULL || path == NULL)
+	if (filter == NULL || value == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (ail_appinfo_get_str(app_info->ail_app_info, AIL_PROP_ICON_STR, &ail_value) != AIL_ERROR_OK)
+	ail_property = app_info_filter_get_ail_property(property, &is_bool);
+
+	if (ail_property == NULL || is_bool == true)
 	{
-		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, "not a string property");
 	}
 
-	path_dup = strdup(ail_value);
-
-	if (path_dup == NULL)
+	if (ail_filter_add_str(filter->ail_filter, ail_property, value) != AIL_ERROR_OK)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
 	}
 
-	*path = path_dup;
+	filter->index_usable = false;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-
-int app_info_is_equal(app_info_h lhs, app_info_h rhs, bool *equal)
+int app_info_filter_set_range(app_info_filter_h filter, int offset, int limit)
 {
-	if (lhs == NULL || rhs == NULL || equal == NULL)
+	if (filter == NULL || offset < 0)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (!strcmp(lhs->app_id, rhs->app_id))
-	{
-		*equal = true;
-	}
-	else
-	{
-		*equal = false;
-	}
+	filter->offset = offset;
+	filter->limit = limit < 0 ? -1 : limit;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-
-int app_info_clone(app_info_h *clone, app_info_h app_info)
+int app_info_get_app_info(const char *app_id, app_info_h *app_info)
 {
+	app_info_h app_info_created;
+	app_info_index_s *index;
+	const app_info_index_entry_s *entry;
+	app_info_row_s *row;
 	int retval;
 
-	if (clone == NULL || app_info == NULL)
+	if (app_id == NULL || app_info == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	retval = app_info_create(app_info->app_id, clone);
+	// the index is only handed out while it matches the database, so its entry vouches for the application like the listings do
+	index = app_info_index_acquire();
+	entry = index != NULL ? app_info_index_lookup(index, app_id) : NULL;
 
-	if (retval != APP_MANAGER_ERROR_NONE)
+	if (entry != NULL)
 	{
-		return app_manager_error(retval, __FUNCTION__, NULL);
+		retval = app_info_create_indexed(index, entry, app_info);
+		app_info_index_release(index);
+		return retval;
 	}
 
-	return APP_MANAGER_ERROR_NONE;
-}
+	app_info_index_release(index);
 
-static pkgmgr_client *package_event_listener = NULL;
-static app_manager_app_info_event_cb app_info_event_cb = NULL;
-static void *app_info_event_cb_data = NULL;
+	// a handle is only given out for an application AIL has, and the app_id is only interned then since the table is never freed
+	retval = app_info_cache_get_row(app_id, &row);
 
-static app_info_event_e app_info_get_app_info_event(const char *value)
-{
-	if (!strcasecmp(value, "install"))
-	{
-		return APP_INFO_EVENT_INSTALLED;
-	}
-	else if (!strcasecmp(value, "uninstall"))
-	{
-		return APP_INFO_EVENT_UNINSTALLED;	
-	}
-	else if (!strcasecmp(value, "update"))
-	{
-		return APP_INFO_EVENT_UPDATED;		
-	}
-	else
+	if (retval != APP_MANAGER_ERROR_NONE)
 	{
-		return APP_MANAGER_ERROR_INVALID_PARAMETER;
+		return retval;
 	}
-}
 
-static int app_info_package_event_listener_cb(
-	int id, const char *type, const char *package, const char *key, const char *val, const void *msg, void *data)
-{
-	static int event_id = -1;
-	static app_info_event_e event_type = -1;
+	retval = app_info_create(row->app_id, &app_info_created);
 
-	if (!strcasecmp(key, "start"))
+	if (retval != APP_MANAGER_ERROR_NONE)
 	{
-		event_id = id;
-		event_type = app_info_get_app_info_event(val);
+		app_info_row_unref(row);
+		return retval;
 	}
-	else if (!strcasecmp(key, "end") && !strcasecmp(val, "ok") && id == event_id)
-	{
-		if (app_info_event_cb != NULL && event_type >= 0)
-		{
-			app_info_h app_info;
-			
-			if (app_info_create(package, &app_info) == APP_MANAGER_ERROR_NONE)
-			{
-				app_info_event_cb(app_info, event_type, app_info_event_cb_data);
-				app_info_destroy(app_info);
-			}
-		}
 
-		event_id = -1;
-		event_type = -1;
-	}
+	// the row just loaded is handed over, the handle is not shared yet
+	app_info_created->row = row;
+
+	*app_info = app_info_created;
 
 	return APP_MANAGER_ERROR_NONE;
 }
 
-int app_info_set_event_cb(app_manager_app_info_event_cb callback, void *user_data)
+static app_info_row_s *app_info_row_ref(app_info_row_s *row)
 {
-	if (callback == NULL)
+	g_atomic_int_inc(&(row->ref_count));
+
+	return row;
+}
+
+static void app_info_row_unref(app_info_row_s *row)
+{
+	if (g_atomic_int_dec_and_test(&(row->ref_count)))
 	{
-		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+		ail_package_destroy_appinfo(row->ail_app_info);
+		free(row);
 	}
+}
 
-	if (app_info_event_cb == NULL)
+static int app_info_row_load(const char *app_id, app_info_row_s **row)
+{
+	app_info_row_s *row_loaded;
+	ail_appinfo_h ail_app_info;
+	char *ail_app_id = NULL;
+
+	switch (ail_package_get_appinfo(app_id, &ail_app_info))
 	{
-		package_event_listener = pkgmgr_client_new(PC_LISTENING);
-		
-		if (package_event_listener == NULL)
-		{
-			return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
-		}
+	case AIL_ERROR_OK:
+		break;
 
-		pkgmgr_client_listen_status(package_event_listener, app_info_package_event_listener_cb, NULL);
-	}
+	case AIL_ERROR_DB_FAILED:
+		return app_manager_error(APP_MANAGER_ERROR_DB_FAILED, __FUNCTION__, NULL);
 
-	app_info_event_cb = callback;
-	app_info_event_cb_data = user_data;
+	case AIL_ERROR_OUT_OF_MEMORY:
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
 
-	return APP_MANAGER_ERROR_NONE;
-}
+	default:
+		return app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
+	}
 
+	row_loaded = calloc(1, sizeof(app_info_row_s));
 
-void app_info_unset_event_cb(void)
-{
-	if (app_info_event_cb != NULL)
+	if (row_loaded == NULL)
 	{
-		pkgmgr_client_free(package_event_listener);
-		package_event_listener = NULL;
+		ail_package_destroy_appinfo(ail_app_info);
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
 	}
 
-	app_info_event_cb = NULL;
-	app_info_event_cb_data = NULL;
-}
+	if (ail_appinfo_get_str(ail_app_info, AIL_PROP_PACKAGE_STR, &ail_app_id) != AIL_ERROR_OK || ail_app_id == NULL)
+	{
+		ail_package_destroy_appinfo(ail_app_info);
+		free(row_loaded);
+		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+	}
+
+	row_loaded->app_id = app_id_table_intern(ail_app_id);
+
+	if (row_loaded->app_id == NULL)
+	{
+		ail_package_destroy_appinfo(ail_app_info);
+		free(row_loaded);
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	row_loaded->ail_app_info = ail_app_info;
+	row_loaded->ref_count = 1;
+
+	*row = row_loaded;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static void app_info_cache_touch_locked(GList *link)
+{
+	g_queue_unlink(&(app_info_cache.lru), link);
+	g_queue_push_head_link(&(app_info_cache.lru), link);
+}
+
+static void app_info_cache_remove_locked(GList *link)
+{
+	app_info_row_s *row = link->data;
+
+	g_hash_table_remove(app_info_cache.row_table, row->app_id);
+	g_queue_delete_link(&(app_info_cache.lru), link);
+	app_info_row_unref(row);
+}
+
+static int app_info_cache_get_row(const char *app_id, app_info_row_s **row)
+{
+	app_info_row_s *row_loaded;
+	unsigned int generation;
+	GList *link;
+	int retval;
+
+	// rows are only cached while the package events can invalidate them
+	if (app_info_start_package_event_listener() != APP_MANAGER_ERROR_NONE)
+	{
+		return app_info_row_load(app_id, row);
+	}
+
+	pthread_mutex_lock(&app_info_cache_mutex);
+
+	if (app_info_cache.row_table == NULL)
+	{
+		app_info_cache.row_table = g_hash_table_new(g_str_hash, g_str_equal);
+	}
+
+	link = g_hash_table_lookup(app_info_cache.row_table, app_id);
+
+	if (link != NULL)
+	{
+		app_info_cache.hits++;
+		app_info_cache_touch_locked(link);
+		*row = app_info_row_ref(link->data);
+		pthread_mutex_unlock(&app_info_cache_mutex);
+		return APP_MANAGER_ERROR_NONE;
+	}
+
+	app_info_cache.misses++;
+	generation = app_info_cache.generation;
+
+	pthread_mutex_unlock(&app_info_cache_mutex);
+
+	retval = app_info_row_load(app_id, &row_loaded);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return retval;
+	}
+
+	pthread_mutex_lock(&app_info_cache_mutex);
+
+	// a row loaded across an invalidation may already be stale, so it is handed out uncached
+	if (generation == app_info_cache.generation)
+	{
+		link = g_hash_table_lookup(app_info_cache.row_table, row_loaded->app_id);
+
+		if (link != NULL)
+		{
+			app_info_cache_touch_locked(link);
+		}
+		else
+		{
+			g_queue_push_head(&(app_info_cache.lru), app_info_row_ref(row_loaded));
+			g_hash_table_insert(app_info_cache.row_table, (gpointer)row_loaded->app_id, app_info_cache.lru.head);
+
+			if (app_info_cache.lru.length > APP_INFO_CACHE_SIZE)
+			{
+				app_info_cache_remove_locked(app_info_cache.lru.tail);
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&app_info_cache_mutex);
+
+	*row = row_loaded;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static bool app_info_cache_peek_row(const char *app_id, app_info_row_s **row)
+{
+	GList *link = NULL;
+
+	pthread_mutex_lock(&app_info_cache_mutex);
+
+	if (app_info_cache.row_table != NULL)
+	{
+		link = g_hash_table_lookup(app_info_cache.row_table, app_id);
+	}
+
+	if (link != NULL)
+	{
+		app_info_cache.hits++;
+		app_info_cache_touch_locked(link);
+		*row = app_info_row_ref(link->data);
+	}
+
+	pthread_mutex_unlock(&app_info_cache_mutex);
+
+	return link != NULL;
+}
+
+static void app_info_cache_invalidate(const char *app_id)
+{
+	GList *link;
+
+	pthread_mutex_lock(&app_info_cache_mutex);
+
+	app_info_cache.generation++;
+
+	if (app_info_cache.row_table != NULL)
+	{
+		link = g_hash_table_lookup(app_info_cache.row_table, app_id);
+
+		if (link != NULL)
+		{
+			app_info_cache_remove_locked(link);
+		}
+	}
+
+	pthread_mutex_unlock(&app_info_cache_mutex);
+}
+
+void app_info_get_pool_stats(app_manager_handle_pool_stats_s *stats)
+{
+	handle_pool_get_stats(&app_info_pool, stats);
+}
+
+int app_info_get_cache_stats(unsigned int *hits, unsigned int *misses)
+{
+	if (hits == NULL || misses == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	pthread_mutex_lock(&app_info_cache_mutex);
+
+	*hits = app_info_cache.hits;
+	*misses = app_info_cache.misses;
+
+	pthread_mutex_unlock(&app_info_cache_mutex);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static int app_info_create(const char *app_id, app_info_h *app_info)
+{
+	app_info_h app_info_created;
+	const char *interned;
+
+	if (app_id == NULL || app_info == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	interned = app_id_table_intern(app_id);
+
+	if (interned == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	app_info_created = handle_pool_take(&app_info_pool);
+
+	if (app_info_created == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	app_info_created->ref_count = 1;
+	app_info_created->app_id = interned;
+	app_info_created->borrowed_ail_app_info = NULL;
+	app_info_created->row = NULL;
+	app_info_created->index = NULL;
+	app_info_created->index_entry = NULL;
+
+	*app_info = app_info_created;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static int app_info_get_ail_app_info(app_info_h app_info, ail_appinfo_h *ail_app_info)
+{
+	app_info_row_s *row;
+	int retval;
+
+	if (app_info->borrowed_ail_app_info != NULL)
+	{
+		*ail_app_info = app_info->borrowed_ail_app_info;
+		return APP_MANAGER_ERROR_NONE;
+	}
+
+	row = g_atomic_pointer_get(&(app_info->row));
+
+	if (row == NULL)
+	{
+		retval = app_info_cache_get_row(app_info->app_id, &row);
+
+		if (retval != APP_MANAGER_ERROR_NONE)
+		{
+			return retval;
+		}
+
+		// clones share the handle, so another thread may have loaded the row meanwhile
+		if (!g_atomic_pointer_compare_and_exchange(&(app_info->row), NULL, row))
+		{
+			app_info_row_unref(row);
+			row = g_atomic_pointer_get(&(app_info->row));
+		}
+	}
+
+	*ail_app_info = row->ail_app_info;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static int app_info_create_borrowed(ail_appinfo_h ail_app_info, app_info_h *app_info)
+{
+	app_info_h app_info_created;
+	char *app_id = NULL;
+
+	if (ail_appinfo_get_str(ail_app_info, AIL_PROP_PACKAGE_STR, &app_id) != AIL_ERROR_OK || app_id == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+	}
+
+	app_info_created = handle_pool_take(&app_info_pool);
+
+	if (app_info_created == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	// the row belongs to AIL and is only valid while it is being listed, the app_id is interned to compare equal to the other handles
+	app_info_created->app_id = app_id_table_intern(app_id);
+
+	if (app_info_created->app_id == NULL)
+	{
+		handle_pool_release(&app_info_pool, app_info_created);
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	app_info_created->borrowed_ail_app_info = ail_app_info;
+	app_info_created->row = NULL;
+
+	*app_info = app_info_created;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_destroy(app_info_h app_info)
+{
+	if (app_info == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	if (app_info->borrowed_ail_app_info != NULL)
+	{
+		handle_pool_release(&app_info_pool, app_info);
+	}
+	else if (g_atomic_int_dec_and_test(&(app_info->ref_count)))
+	{
+		if (app_info->row != NULL)
+		{
+			app_info_row_unref(app_info->row);
+		}
+
+		app_info_index_release(app_info->index);
+
+		handle_pool_release(&app_info_pool, app_info);
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_get_app_id(app_info_h app_info, char **app_id)
+{
+	char *app_id_dup;
+
+	if (app_info == NULL || app_id == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	app_id_dup = strdup(app_info->app_id);
+
+	if (app_id_dup == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	*app_id = app_id_dup;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_get_app_id_peek(app_info_h app_info, const char **app_id)
+{
+	if (app_info == NULL || app_id == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	*app_id = app_info->app_id;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+
+int app_info_get_name(app_info_h app_info, char **name)
+{
+	const char *ail_value;
+	char *name_dup;
+	int retval;
+
+	if (app_info == NULL || name == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_get_name_peek(app_info, &ail_value);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	name_dup = strdup(ail_value);
+
+	if (name_dup == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	*name = name_dup;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+// the index mapping or the AIL handle owns the value, and either lives as long as app_info
+static int app_info_get_field_peek(app_info_h app_info, app_info_index_field_e field, const char **value)
+{
+	ail_appinfo_h ail_app_info;
+	char *ail_value = NULL;
+	int retval;
+
+	// a value AIL does not have is an error whether the index or the row is asked
+	if (app_info->index_entry != NULL)
+	{
+		*value = app_info_index_get_field(app_info->index, app_info->index_entry, field);
+		return *value != NULL ? APP_MANAGER_ERROR_NONE : APP_MANAGER_ERROR_IO_ERROR;
+	}
+
+	retval = app_info_get_ail_app_info(app_info, &ail_app_info);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return retval;
+	}
+
+	if (ail_appinfo_get_str(ail_app_info, app_info_table_column_property(field), &ail_value) != AIL_ERROR_OK || ail_value == NULL)
+	{
+		return APP_MANAGER_ERROR_IO_ERROR;
+	}
+
+	*value = ail_value;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_get_name_peek(app_info_h app_info, const char **name)
+{
+	int retval;
+
+	if (app_info == NULL || name == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_get_field_peek(app_info, APP_INFO_INDEX_FIELD_NAME, name);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+
+int app_info_get_version(app_info_h app_info, char **version)
+{
+	const char *ail_value;
+	char *version_dup;
+	int retval;
+
+	if (app_info == NULL || version == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_get_version_peek(app_info, &ail_value);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	version_dup = strdup(ail_value);
+
+	if (version_dup == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	*version = version_dup;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_get_version_peek(app_info_h app_info, const char **version)
+{
+	int retval;
+
+	if (app_info == NULL || version == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_get_field_peek(app_info, APP_INFO_INDEX_FIELD_VERSION, version);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+
+int app_info_get_icon(app_info_h app_info, char **path)
+{
+	const char *ail_value;
+	char *path_dup;
+	int retval;
+
+	if (app_info == NULL || path == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_get_icon_peek(app_info, &ail_value);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	path_dup = strdup(ail_value);
+
+	if (path_dup == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	*path = path_dup;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_get_icon_peek(app_info_h app_info, const char **path)
+{
+	int retval;
+
+	if (app_info == NULL || path == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_get_field_peek(app_info, APP_INFO_INDEX_FIELD_ICON, path);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+
+int app_info_is_equal(app_info_h lhs, app_info_h rhs, bool *equal)
+{
+	if (lhs == NULL || rhs == NULL || equal == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	if (lhs->app_id == rhs->app_id)
+	{
+		*equal = true;
+	}
+	else
+	{
+		*equal = false;
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+
+int app_info_clone(app_info_h *clone, app_info_h app_info)
+{
+	int retval;
+
+	if (clone == NULL || app_info == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	if (app_info->borrowed_ail_app_info == NULL)
+	{
+		g_atomic_int_inc(&(app_info->ref_count));
+		*clone = app_info;
+		return APP_MANAGER_ERROR_NONE;
+	}
+
+	retval = app_info_create(app_info->app_id, clone);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+#define APP_INFO_TABLE_COLUMNS 3
+
+#define APP_INFO_TABLE_PROPERTIES (APP_INFO_PROPERTY_NAME | APP_INFO_PROPERTY_ICON | APP_INFO_PROPERTY_VERSION)
+
+// the offsets of the cells that hold no value, for an application that is not installed or a property it does not have
+#define APP_INFO_TABLE_NO_APP -1
+#define APP_INFO_TABLE_ABSENT -2
+
+struct app_info_table_s {
+	int count;
+	int properties;
+	int offsets[];
+};
+
+typedef struct _table_context_ {
+	int properties;
+	GHashTable *pending;
+	int *offsets;
+	GString *values;
+} table_context_s;
+
+static const char *app_info_table_column_property(int column)
+{
+	switch (column)
+	{
+	case 0:
+		return AIL_PROP_NAME_STR;
+
+	case 1:
+		return AIL_PROP_ICON_STR;
+
+	default:
+		return AIL_PROP_VERSION_STR;
+	}
+}
+
+static int app_info_table_property_column(app_info_property_e property)
+{
+	switch (property)
+	{
+	case APP_INFO_PROPERTY_NAME:
+		return 0;
+
+	case APP_INFO_PROPERTY_ICON:
+		return 1;
+
+	case APP_INFO_PROPERTY_VERSION:
+		return 2;
+
+	default:
+		return -1;
+	}
+}
+
+static void app_info_table_fill(table_context_s *table_context, int index, ail_appinfo_h ail_app_info)
+{
+	char *ail_value;
+	int column;
+
+	for (column = 0; column < APP_INFO_TABLE_COLUMNS; column++)
+	{
+		if ((table_context->properties & (1 << column)) == 0)
+		{
+			continue;
+		}
+
+		ail_value = NULL;
+
+		if (ail_appinfo_get_str(ail_app_info, app_info_table_column_property(column), &ail_value) != AIL_ERROR_OK || ail_value == NULL)
+		{
+			table_context->offsets[index * APP_INFO_TABLE_COLUMNS + column] = APP_INFO_TABLE_ABSENT;
+			continue;
+		}
+
+		table_context->offsets[index * APP_INFO_TABLE_COLUMNS + column] = table_context->values->len;
+		g_string_append_len(table_context->values, ail_value, strlen(ail_value) + 1);
+	}
+}
+
+static void app_info_table_fill_indexed(table_context_s *table_context, int index, app_info_index_s *app_info_index, const app_info_index_entry_s *entry)
+{
+	const char *value;
+	int column;
+
+	// the table columns are laid out like the index fields
+	for (column = 0; column < APP_INFO_TABLE_COLUMNS; column++)
+	{
+		if ((table_context->properties & (1 << column)) == 0)
+		{
+			continue;
+		}
+
+		value = app_info_index_get_field(app_info_index, entry, column);
+
+		if (value == NULL)
+		{
+			table_context->offsets[index * APP_INFO_TABLE_COLUMNS + column] = APP_INFO_TABLE_ABSENT;
+			continue;
+		}
+
+		table_context->offsets[index * APP_INFO_TABLE_COLUMNS + column] = table_context->values->len;
+		g_string_append_len(table_context->values, value, strlen(value) + 1);
+	}
+}
+
+static ail_cb_ret_e app_info_table_fill_cb(const ail_appinfo_h ail_app_info, void *cb_data)
+{
+	table_context_s *table_context = cb_data;
+	char *app_id = NULL;
+	gpointer index;
+
+	if (ail_appinfo_get_str(ail_app_info, AIL_PROP_PACKAGE_STR, &app_id) != AIL_ERROR_OK || app_id == NULL)
+	{
+		return AIL_CB_RET_CONTINUE;
+	}
+
+	if (g_hash_table_lookup_extended(table_context->pending, app_id, NULL, &index))
+	{
+		app_info_table_fill(table_context, GPOINTER_TO_INT(index), ail_app_info);
+		g_hash_table_remove(table_context->pending, app_id);
+	}
+
+	return g_hash_table_size(table_context->pending) > 0 ? AIL_CB_RET_CONTINUE : AIL_CB_RET_CANCEL;
+}
+
+int app_info_get_app_info_table(const char **app_ids, int count, int properties, app_info_table_h *table)
+{
+	table_context_s table_context = {
+		.properties = properties,
+	};
+	GHashTable *first_index;
+	app_info_table_h table_created;
+	app_info_index_s *app_info_index;
+	const app_info_index_entry_s *entry;
+	app_info_row_s *row;
+	gpointer index;
+	int cells;
+	int i;
+
+	if (app_ids == NULL || count < 0 || properties <= 0 || (properties & ~APP_INFO_TABLE_PROPERTIES) != 0 || table == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		if (app_ids[i] == NULL)
+		{
+			return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+		}
+	}
+
+	cells = count * APP_INFO_TABLE_COLUMNS;
+
+	table_context.offsets = malloc((cells > 0 ? cells : 1) * sizeof(int));
+
+	if (table_context.offsets == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	for (i = 0; i < cells; i++)
+	{
+		table_context.offsets[i] = APP_INFO_TABLE_NO_APP;
+	}
+
+	table_context.values = g_string_new(NULL);
+	table_context.pending = g_hash_table_new(g_str_hash, g_str_equal);
+	first_index = g_hash_table_new(g_str_hash, g_str_equal);
+	app_info_index = app_info_index_acquire();
+
+	// indexed and cached applications are used as they are, the rest is picked up by a single pass over the whole database
+	for (i = 0; i < count; i++)
+	{
+		if (g_hash_table_lookup_extended(first_index, app_ids[i], NULL, NULL))
+		{
+			continue;
+		}
+
+		g_hash_table_insert(first_index, (gpointer)app_ids[i], GINT_TO_POINTER(i));
+
+		entry = app_info_index != NULL ? app_info_index_lookup(app_info_index, app_ids[i]) : NULL;
+
+		if (entry != NULL)
+		{
+			app_info_table_fill_indexed(&table_context, i, app_info_index, entry);
+		}
+		else if (app_info_cache_peek_row(app_ids[i], &row) == true)
+		{
+			app_info_table_fill(&table_context, i, row->ail_app_info);
+			app_info_row_unref(row);
+		}
+		else
+		{
+			g_hash_table_insert(table_context.pending, (gpointer)app_ids[i], GINT_TO_POINTER(i));
+		}
+	}
+
+	if (app_info_index != NULL)
+	{
+		app_info_index_release(app_info_index);
+	}
+
+	if (g_hash_table_size(table_context.pending) > 0)
+	{
+		ail_filter_list_appinfo_foreach(NULL, app_info_table_fill_cb, &table_context);
+	}
+
+	// repeated app_ids share the values of their first occurrence
+	for (i = 0; i < count; i++)
+	{
+		g_hash_table_lookup_extended(first_index, app_ids[i], NULL, &index);
+
+		if (GPOINTER_TO_INT(index) != i)
+		{
+			memcpy(&(table_context.offsets[i * APP_INFO_TABLE_COLUMNS]),
+					&(table_context.offsets[GPOINTER_TO_INT(index) * APP_INFO_TABLE_COLUMNS]),
+					APP_INFO_TABLE_COLUMNS * sizeof(int));
+		}
+	}
+
+	g_hash_table_destroy(first_index);
+	g_hash_table_destroy(table_context.pending);
+
+	// a single block holds the header, the offsets and the values they point at
+	table_created = malloc(sizeof(struct app_info_table_s) + cells * sizeof(int) + table_context.values->len);
+
+	if (table_created == NULL)
+	{
+		free(table_context.offsets);
+		g_string_free(table_context.values, TRUE);
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	table_created->count = count;
+	table_created->properties = properties;
+	memcpy(table_created->offsets, table_context.offsets, cells * sizeof(int));
+	memcpy(&(table_created->offsets[cells]), table_context.values->str, table_context.values->len);
+
+	free(table_context.offsets);
+	g_string_free(table_context.values, TRUE);
+
+	*table = table_created;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_table_get_value(app_info_table_h table, int index, app_info_property_e property, const char **value)
+{
+	const char *values;
+	int column;
+	int offset;
+
+	column = app_info_table_property_column(property);
+
+	if (table == NULL || index < 0 || index >= table->count || column < 0 || (table->properties & property) == 0 || value == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	offset = table->offsets[index * APP_INFO_TABLE_COLUMNS + column];
+
+	// a missing property fails like app_manager_get_app_property() does
+	if (offset == APP_INFO_TABLE_ABSENT)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+	}
+
+	if (offset == APP_INFO_TABLE_NO_APP)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_NO_SUCH_APP, __FUNCTION__, NULL);
+	}
+
+	values = (const char *)&(table->offsets[table->count * APP_INFO_TABLE_COLUMNS]);
+
+	*value = values + offset;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_table_destroy(app_info_table_h table)
+{
+	if (table == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	free(table);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+// the value is owned by the index mapping or the row handed back, which are released by app_info_release_app_property()
+static int app_info_lookup_app_property(const char *app_id, app_info_property_e property, app_info_index_s **index, app_info_row_s **row, const char **value)
+{
+	const app_info_index_entry_s *entry;
+	char *ail_value = NULL;
+	int column;
+	int retval;
+
+	column = app_info_table_property_column(property);
+
+	if (app_id == NULL || column < 0)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	*index = app_info_index_acquire();
+
+	if (*index != NULL)
+	{
+		entry = app_info_index_lookup(*index, app_id);
+
+		if (entry != NULL)
+		{
+			*row = NULL;
+			*value = app_info_index_get_field(*index, entry, column);
+
+			if (*value == NULL)
+			{
+				app_info_index_release(*index);
+				return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+			}
+
+			return APP_MANAGER_ERROR_NONE;
+		}
+
+		app_info_index_release(*index);
+		*index = NULL;
+	}
+
+	retval = app_info_cache_get_row(app_id, row);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return retval;
+	}
+
+	if (ail_appinfo_get_str((*row)->ail_app_info, app_info_table_column_property(column), &ail_value) != AIL_ERROR_OK || ail_value == NULL)
+	{
+		app_info_row_unref(*row);
+		return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+	}
+
+	*value = ail_value;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static void app_info_release_app_property(app_info_index_s *index, app_info_row_s *row)
+{
+	if (index != NULL)
+	{
+		app_info_index_release(index);
+	}
+
+	if (row != NULL)
+	{
+		app_info_row_unref(row);
+	}
+}
+
+int app_info_get_app_property(const char *app_id, app_info_property_e property, char *buffer, int size)
+{
+	app_info_index_s *index;
+	app_info_row_s *row;
+	const char *property_value;
+	int length;
+	int retval;
+
+	if (buffer == NULL || size <= 0)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_lookup_app_property(app_id, property, &index, &row, &property_value);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return retval;
+	}
+
+	length = strlen(property_value);
+
+	if (length < size)
+	{
+		memcpy(buffer, property_value, length + 1);
+	}
+
+	app_info_release_app_property(index, row);
+
+	if (length >= size)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, "buffer too small");
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_dup_app_property(const char *app_id, app_info_property_e property, char **value)
+{
+	app_info_index_s *index;
+	app_info_row_s *row;
+	const char *property_value;
+	char *value_dup;
+	int retval;
+
+	if (value == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_lookup_app_property(app_id, property, &index, &row, &property_value);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return retval;
+	}
+
+	value_dup = strdup(property_value);
+
+	app_info_release_app_property(index, row);
+
+	if (value_dup == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+	}
+
+	*value = value_dup;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+static app_manager_app_info_event_cb app_info_event_cb = NULL;
+static void *app_info_event_cb_data = NULL;
+static app_manager_app_info_progress_cb app_info_progress_cb = NULL;
+static void *app_info_progress_cb_data = NULL;
+
+/*
+ * Batched events are collected until no package operation is in flight or until the window
+ * that started with the first collected event expires, whichever comes first. The window
+ * runs on the default main context, where the package manager delivers its messages. Without
+ * a window the hub's request timeout bounds a batch whose operations never report their end,
+ * and a batch that reaches APP_INFO_BATCH_RECORD_MAX changes is delivered right away.
+ */
+#define APP_INFO_BATCH_RECORD_MAX 256
+
+typedef struct _app_info_batch_ {
+	app_manager_app_info_batch_event_cb callback;
+	void *user_data;
+	unsigned int window;
+	guint timer;
+	GArray *records;
+} app_info_batch_s;
+
+static pthread_mutex_t app_info_batch_mutex = PTHREAD_MUTEX_INITIALIZER;
+static app_info_batch_s app_info_batch;
+
+static void app_info_batch_flush(void)
+{
+	app_manager_app_info_batch_event_cb callback;
+	void *user_data;
+	GArray *records;
+
+	pthread_mutex_lock(&app_info_batch_mutex);
+
+	callback = app_info_batch.callback;
+	user_data = app_info_batch.user_data;
+	records = app_info_batch.records;
+	app_info_batch.records = NULL;
+
+	if (app_info_batch.timer != 0)
+	{
+		g_source_remove(app_info_batch.timer);
+		app_info_batch.timer = 0;
+	}
+
+	pthread_mutex_unlock(&app_info_batch_mutex);
+
+	if (records == NULL)
+	{
+		return;
+	}
+
+	if (callback != NULL && records->len > 0)
+	{
+		callback((const app_info_event_record_s *)records->data, records->len, user_data);
+	}
+
+	g_array_free(records, TRUE);
+}
+
+static gboolean app_info_batch_timeout_cb(gpointer data)
+{
+	pthread_mutex_lock(&app_info_batch_mutex);
+	app_info_batch.timer = 0;
+	pthread_mutex_unlock(&app_info_batch_mutex);
+
+	app_info_batch_flush();
+
+	return FALSE;
+}
+
+static void app_info_batch_add(const char *app_id, app_info_event_e event)
+{
+	app_info_event_record_s record;
+	const char *interned;
+	unsigned int i;
+	bool full;
+
+	pthread_mutex_lock(&app_info_batch_mutex);
+
+	interned = app_info_batch.callback != NULL ? app_id_table_intern(app_id) : NULL;
+
+	if (interned == NULL)
+	{
+		pthread_mutex_unlock(&app_info_batch_mutex);
+		return;
+	}
+
+	if (app_info_batch.records == NULL)
+	{
+		app_info_batch.records = g_array_new(FALSE, FALSE, sizeof(app_info_event_record_s));
+
+		app_info_batch.timer = g_timeout_add(
+				app_info_batch.window > 0 ? app_info_batch.window : PACKAGE_EVENT_REQUEST_TIMEOUT * 1000,
+				app_info_batch_timeout_cb, NULL);
+	}
+
+	// the same change reported twice in one batch is delivered once
+	for (i = 0; i < app_info_batch.records->len; i++)
+	{
+		record = g_array_index(app_info_batch.records, app_info_event_record_s, i);
+
+		if (record.event == event && record.app_id == interned)
+		{
+			pthread_mutex_unlock(&app_info_batch_mutex);
+			return;
+		}
+	}
+
+	record.app_id = interned;
+	record.event = event;
+
+	g_array_append_val(app_info_batch.records, record);
+
+	full = app_info_batch.records->len >= APP_INFO_BATCH_RECORD_MAX;
+
+	pthread_mutex_unlock(&app_info_batch_mutex);
 
+	if (full == true)
+	{
+		app_info_batch_flush();
+	}
+}
+
+static app_info_event_e app_info_get_app_info_event(package_event_type_e type)
+{
+	switch (type)
+	{
+	case PACKAGE_EVENT_TYPE_INSTALL:
+		return APP_INFO_EVENT_INSTALLED;
+
+	case PACKAGE_EVENT_TYPE_UNINSTALL:
+		return APP_INFO_EVENT_UNINSTALLED;
+
+	case PACKAGE_EVENT_TYPE_UPDATE:
+		return APP_INFO_EVENT_UPDATED;
+
+	default:
+		return APP_MANAGER_ERROR_INVALID_PARAMETER;
+	}
+}
+
+static void app_info_package_event_cb(const char *package, package_event_type_e type, package_event_state_e state, int progress, void *user_data)
+{
+	app_manager_app_info_event_cb callback = app_info_event_cb;
+	app_manager_app_info_progress_cb progress_callback = app_info_progress_cb;
+	app_info_event_e event_type = app_info_get_app_info_event(type);
+	app_info_h app_info;
+
+	if (state == PACKAGE_EVENT_STATE_IDLE)
+	{
+		app_info_batch_flush();
+		return;
+	}
+
+	if (state == PACKAGE_EVENT_STATE_PROGRESS)
+	{
+		if (progress_callback != NULL && event_type >= 0)
+		{
+			progress_callback(package, event_type, progress, app_info_progress_cb_data);
+		}
+
+		return;
+	}
+
+	app_info_cache_invalidate(package);
+
+	if (state == PACKAGE_EVENT_STATE_COMPLETED && event_type >= 0)
+	{
+		app_info_batch_add(package, event_type);
+	}
+
+	if (state == PACKAGE_EVENT_STATE_COMPLETED && callback != NULL && event_type >= 0)
+	{
+		if (app_info_create(package, &app_info) == APP_MANAGER_ERROR_NONE)
+		{
+			callback(app_info, event_type, app_info_event_cb_data);
+			app_info_destroy(app_info);
+		}
+	}
+}
+
+static volatile int app_info_package_event_listening = 0;
+
+// registering takes the hub mutex, which would serialize every cache lookup once the listener is up
+static int app_info_start_package_event_listener(void)
+{
+	int retval;
+
+	if (g_atomic_int_get(&app_info_package_event_listening))
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+
+	retval = package_event_add_listener(app_info_package_event_cb, NULL);
+
+	if (retval == APP_MANAGER_ERROR_NONE)
+	{
+		g_atomic_int_set(&app_info_package_event_listening, 1);
+	}
+
+	return retval;
+}
+
+int app_info_set_event_cb(app_manager_app_info_event_cb callback, void *user_data)
+{
+	int retval;
+
+	if (callback == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_start_package_event_listener();
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	app_info_event_cb = callback;
+	app_info_event_cb_data = user_data;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+
+int app_info_set_progress_cb(app_manager_app_info_progress_cb callback, void *user_data)
+{
+	int retval;
+
+	if (callback == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_start_package_event_listener();
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	app_info_progress_cb = callback;
+	app_info_progress_cb_data = user_data;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_info_set_batch_event_cb(unsigned int window, app_manager_app_info_batch_event_cb callback, void *user_data)
+{
+	int retval;
+
+	if (callback == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	retval = app_info_start_package_event_listener();
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+
+	pthread_mutex_lock(&app_info_batch_mutex);
+
+	app_info_batch.callback = callback;
+	app_info_batch.user_data = user_data;
+	app_info_batch.window = window;
+
+	pthread_mutex_unlock(&app_info_batch_mutex);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+void app_info_unset_batch_event_cb(void)
+{
+	GArray *records;
+
+	pthread_mutex_lock(&app_info_batch_mutex);
+
+	records = app_info_batch.records;
+	app_info_batch.records = NULL;
+	app_info_batch.callback = NULL;
+	app_info_batch.user_data = NULL;
+
+	if (app_info_batch.timer != 0)
+	{
+		g_source_remove(app_info_batch.timer);
+		app_info_batch.timer = 0;
+	}
+
+	pthread_mutex_unlock(&app_info_batch_mutex);
+
+	// a pending batch belongs to the callback that is going away
+	if (records != NULL)
+	{
+		g_array_free(records, TRUE);
+	}
+}
+
+void app_info_unset_progress_cb(void)
+{
+	app_info_progress_cb = NULL;
+	app_info_progress_cb_data = NULL;
+}
+
+void app_info_unset_event_cb(void)
+{
+	// the listener stays, the cached rows still depend on it
+	app_info_event_cb = NULL;
+	app_info_event_cb_data = NULL;
+}
@@ -0,0 +1,736 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <glib.h>
+
+#include <ail.h>
+#include <dlog.h>
+
+#include <app_manager.h>
+#include <app_manager_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_APP_MANAGER"
+
+#define APP_INFO_INDEX_MAGIC 0x58494d41 // "AMIX"
+#define APP_INFO_INDEX_VERSION 3
+
+// the offset of a field AIL has no value for
+#define APP_INFO_INDEX_ABSENT UINT32_MAX
+
+// a failed load or build is not retried before this many seconds have passed
+#define APP_INFO_INDEX_RETRY_INTERVAL 10
+
+#ifndef AIL_DB_PATH
+#define AIL_DB_PATH "/opt/dbspace/.app_info.db"
+#endif
+
+/*
+ * The index is a snapshot of the installed applications written in one go from AIL and read
+ * through a shared read-only mapping. The entries keep the order AIL lists the applications
+ * in and refer to NUL-terminated strings by their offsets into the string area; a second
+ * array holds the entry numbers sorted by app_id for the lookups. Nothing is parsed when
+ * the file is mapped, only the offsets are checked to stay within the file.
+ *
+ * A new file is written under a temporary name and renamed over the old one, so a process
+ * still mapping the old file keeps reading a consistent snapshot. Processes take turns at
+ * rebuilding through a lock file next to it, and one that gets its turn after another has
+ * written a file for the same database maps that file instead of writing its own.
+ *
+ * The header is stamped with the identity, size and modification time of the AIL database as
+ * they were before it was read. A file whose stamp does not match the database any more was
+ * built before some package operation nobody was listening to, and is rebuilt instead.
+ */
+typedef struct _app_info_index_stamp_ {
+	uint64_t inode;
+	uint64_t size;
+	uint64_t mtime; // in nanoseconds
+	uint64_t wal_size;
+	uint64_t wal_mtime;
+} app_info_index_stamp_s;
+
+typedef struct _app_info_index_header_ {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t size;
+	uint32_t count;
+	uint32_t entries_offset;
+	uint32_t sorted_offset;
+	uint32_t strings_offset;
+	uint32_t strings_size;
+	app_info_index_stamp_s stamp;
+} app_info_index_header_s;
+
+struct _app_info_index_entry_ {
+	uint32_t app_id;
+	uint32_t fields[APP_INFO_INDEX_FIELD_MAX];
+	uint32_t flags;
+};
+
+struct _app_info_index_ {
+	volatile int ref_count;
+	void *map;
+	size_t size;
+	const app_info_index_header_s *header;
+	const app_info_index_entry_s *entries;
+	const uint32_t *sorted;
+	const char *strings;
+};
+
+static pthread_mutex_t app_info_index_mutex = PTHREAD_MUTEX_INITIALIZER;
+static char *app_info_index_path = NULL;
+static app_info_index_s *app_info_index = NULL;
+static bool app_info_index_listening = false;
+static int app_info_index_retry_time = 0;
+static bool app_info_index_loading = false;
+static unsigned int app_info_index_generation = 0;
+
+typedef struct _index_builder_ {
+	GArray *entries;
+	GString *strings;
+	GHashTable *string_offsets;
+} index_builder_s;
+
+typedef struct _index_sort_key_ {
+	const char *app_id;
+	uint32_t entry;
+} index_sort_key_s;
+
+static int app_info_index_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec;
+}
+
+// sqlite may keep the latest writes in the write-ahead log, so it takes part in the stamp
+static bool app_info_index_get_stamp(app_info_index_stamp_s *stamp)
+{
+	struct stat st;
+
+	memset(stamp, 0, sizeof(app_info_index_stamp_s));
+
+	if (stat(AIL_DB_PATH, &st) != 0)
+	{
+		return false;
+	}
+
+	stamp->inode = st.st_ino;
+	stamp->size = st.st_size;
+	stamp->mtime = (uint64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+
+	if (stat(AIL_DB_PATH "-wal", &st) == 0)
+	{
+		stamp->wal_size = st.st_size;
+		stamp->wal_mtime = (uint64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+	}
+
+	return true;
+}
+
+static const char *app_info_index_field_property(app_info_index_field_e field)
+{
+	switch (field)
+	{
+	case APP_INFO_INDEX_FIELD_NAME:
+		return AIL_PROP_NAME_STR;
+
+	case APP_INFO_INDEX_FIELD_ICON:
+		return AIL_PROP_ICON_STR;
+
+	default:
+		return AIL_PROP_VERSION_STR;
+	}
+}
+
+// equal strings, such as the versions, are stored once
+static uint32_t app_info_index_add_string(index_builder_s *builder, const char *value)
+{
+	gpointer offset;
+
+	if (g_hash_table_lookup_extended(builder->string_offsets, value, NULL, &offset))
+	{
+		return GPOINTER_TO_UINT(offset);
+	}
+
+	offset = GUINT_TO_POINTER(builder->strings->len);
+	g_string_append_len(builder->strings, value, strlen(value) + 1);
+	g_hash_table_insert(builder->string_offsets, strdup(value), offset);
+
+	return GPOINTER_TO_UINT(offset);
+}
+
+static ail_cb_ret_e app_info_index_build_cb(const ail_appinfo_h ail_app_info, void *cb_data)
+{
+	index_builder_s *builder = cb_data;
+	app_info_index_entry_s entry;
+	char *ail_value = NULL;
+	bool flag;
+	int field;
+
+	if (ail_appinfo_get_str(ail_app_info, AIL_PROP_PACKAGE_STR, &ail_value) != AIL_ERROR_OK || ail_value == NULL)
+	{
+		return AIL_CB_RET_CONTINUE;
+	}
+
+	entry.app_id = app_info_index_add_string(builder, ail_value);
+
+	for (field = 0; field < APP_INFO_INDEX_FIELD_MAX; field++)
+	{
+		ail_value = NULL;
+		ail_appinfo_get_str(ail_app_info, app_info_index_field_property(field), &ail_value);
+		entry.fields[field] = ail_value != NULL ? app_info_index_add_string(builder, ail_value) : APP_INFO_INDEX_ABSENT;
+	}
+
+	entry.flags = 0;
+
+	if (ail_appinfo_get_bool(ail_app_info, AIL_PROP_NODISPLAY_BOOL, &flag) == AIL_ERROR_OK && flag == true)
+	{
+		entry.flags |= APP_INFO_INDEX_FLAG_NODISPLAY;
+	}
+
+	if (ail_appinfo_get_bool(ail_app_info, AIL_PROP_X_SLP_TASKMANAGE_BOOL, &flag) == AIL_ERROR_OK && flag == true)
+	{
+		entry.flags |= APP_INFO_INDEX_FLAG_TASKMANAGE;
+	}
+
+	if (ail_appinfo_get_bool(ail_app_info, AIL_PROP_X_SLP_REMOVABLE_BOOL, &flag) == AIL_ERROR_OK && flag == true)
+	{
+		entry.flags |= APP_INFO_INDEX_FLAG_REMOVABLE;
+	}
+
+	g_array_append_val(builder->entries, entry);
+
+	return AIL_CB_RET_CONTINUE;
+}
+
+static int app_info_index_compare_keys(const void *lhs, const void *rhs)
+{
+	const index_sort_key_s *a = lhs;
+	const index_sort_key_s *b = rhs;
+
+	return strcmp(a->app_id, b->app_id);
+}
+
+static int app_info_index_write(const char *path, const void *data, size_t size)
+{
+	char *temp_path;
+	const char *cursor = data;
+	ssize_t written;
+	int fd;
+
+	temp_path = g_strdup_printf("%s.%d.tmp", path, getpid());
+
+	if (temp_path == NULL)
+	{
+		return APP_MANAGER_ERROR_OUT_OF_MEMORY;
+	}
+
+	fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if (fd < 0)
+	{
+		g_free(temp_path);
+		return APP_MANAGER_ERROR_IO_ERROR;
+	}
+
+	while (size > 0)
+	{
+		written = write(fd, cursor, size);
+
+		if (written <= 0)
+		{
+			close(fd);
+			unlink(temp_path);
+			g_free(temp_path);
+			return APP_MANAGER_ERROR_IO_ERROR;
+		}
+
+		cursor += written;
+		size -= written;
+	}
+
+	if (fsync(fd) != 0 || close(fd) != 0 || rename(temp_path, path) != 0)
+	{
+		unlink(temp_path);
+		g_free(temp_path);
+		return APP_MANAGER_ERROR_IO_ERROR;
+	}
+
+	g_free(temp_path);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+// the stamp of the database as it was read is handed back to check the mapped file against
+static int app_info_index_build(const char *path, app_info_index_stamp_s *stamp)
+{
+	index_builder_s builder;
+	app_info_index_header_s header;
+	index_sort_key_s *keys;
+	GString *file;
+	uint32_t entry;
+	int retval;
+
+	builder.entries = g_array_new(FALSE, FALSE, sizeof(app_info_index_entry_s));
+	builder.strings = g_string_new(NULL);
+	builder.string_offsets = g_hash_table_new_full(g_str_hash, g_str_equal, free, NULL);
+
+	// taken before the database is read, so a change made meanwhile leaves the file outdated
+	app_info_index_get_stamp(stamp);
+
+	if (ail_filter_list_appinfo_foreach(NULL, app_info_index_build_cb, &builder) != AIL_ERROR_OK)
+	{
+		retval = APP_MANAGER_ERROR_DB_FAILED;
+		goto out;
+	}
+
+	keys = malloc((builder.entries->len > 0 ? builder.entries->len : 1) * sizeof(index_sort_key_s));
+
+	if (keys == NULL)
+	{
+		retval = APP_MANAGER_ERROR_OUT_OF_MEMORY;
+		goto out;
+	}
+
+	for (entry = 0; entry < builder.entries->len; entry++)
+	{
+		keys[entry].app_id = builder.strings->str + g_array_index(builder.entries, app_info_index_entry_s, entry).app_id;
+		keys[entry].entry = entry;
+	}
+
+	qsort(keys, builder.entries->len, sizeof(index_sort_key_s), app_info_index_compare_keys);
+
+	header.magic = APP_INFO_INDEX_MAGIC;
+	header.version = APP_INFO_INDEX_VERSION;
+	header.count = builder.entries->len;
+	header.entries_offset = sizeof(app_info_index_header_s);
+	header.sorted_offset = header.entries_offset + header.count * sizeof(app_info_index_entry_s);
+	header.strings_offset = header.sorted_offset + header.count * sizeof(uint32_t);
+	header.strings_size = builder.strings->len;
+	header.size = header.strings_offset + header.strings_size;
+	header.stamp = *stamp;
+
+	file = g_string_sized_new(header.size);
+	g_string_append_len(file, (const char *)&header, sizeof(header));
+	g_string_append_len(file, builder.entries->data, header.count * sizeof(app_info_index_entry_s));
+
+	for (entry = 0; entry < header.count; entry++)
+	{
+		g_string_append_len(file, (const char *)&(keys[entry].entry), sizeof(uint32_t));
+	}
+
+	g_string_append_len(file, builder.strings->str, builder.strings->len);
+
+	free(keys);
+
+	retval = app_info_index_write(path, file->str, file->len);
+
+	g_string_free(file, TRUE);
+
+out:
+	g_hash_table_destroy(builder.string_offsets);
+	g_string_free(builder.strings, TRUE);
+	g_array_free(builder.entries, TRUE);
+
+	return retval;
+}
+
+static bool app_info_index_is_valid(const void *map, size_t size)
+{
+	const app_info_index_header_s *header = map;
+	const app_info_index_entry_s *entries;
+	const uint32_t *sorted;
+	const char *strings;
+	uint32_t i;
+	int field;
+
+	if (size < sizeof(app_info_index_header_s) || header->magic != APP_INFO_INDEX_MAGIC || header->version != APP_INFO_INDEX_VERSION
+			|| header->size != size || header->entries_offset != sizeof(app_info_index_header_s)
+			|| header->sorted_offset != header->entries_offset + (uint64_t)header->count * sizeof(app_info_index_entry_s)
+			|| header->strings_offset != header->sorted_offset + (uint64_t)header->count * sizeof(uint32_t)
+			|| header->strings_offset + (uint64_t)header->strings_size != size)
+	{
+		return false;
+	}
+
+	entries = (const app_info_index_entry_s *)((const char *)map + header->entries_offset);
+	sorted = (const uint32_t *)((const char *)map + header->sorted_offset);
+	strings = (const char *)map + header->strings_offset;
+
+	// a string area ending with NUL keeps every string that starts in it within the file
+	if (header->count > 0 && (header->strings_size == 0 || strings[header->strings_size - 1] != '\0'))
+	{
+		return false;
+	}
+
+	for (i = 0; i < header->count; i++)
+	{
+		if (entries[i].app_id >= header->strings_size || sorted[i] >= header->count)
+		{
+			return false;
+		}
+
+		for (field = 0; field < APP_INFO_INDEX_FIELD_MAX; field++)
+		{
+			if (entries[i].fields[field] != APP_INFO_INDEX_ABSENT && entries[i].fields[field] >= header->strings_size)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static app_info_index_s *app_info_index_map(const char *path, const app_info_index_stamp_s *stamp)
+{
+	app_info_index_s *index;
+	struct stat st;
+	void *map;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+
+	if (fd < 0)
+	{
+		return NULL;
+	}
+
+	if (fstat(fd, &st) != 0 || st.st_size <= 0)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	close(fd);
+
+	if (map == MAP_FAILED)
+	{
+		return NULL;
+	}
+
+	if (app_info_index_is_valid(map, st.st_size) == false
+			|| memcmp(&(((const app_info_index_header_s *)map)->stamp), stamp, sizeof(app_info_index_stamp_s)) != 0)
+	{
+		munmap(map, st.st_size);
+		return NULL;
+	}
+
+	index = calloc(1, sizeof(app_info_index_s));
+
+	if (index == NULL)
+	{
+		munmap(map, st.st_size);
+		return NULL;
+	}
+
+	index->ref_count = 1;
+	index->map = map;
+	index->size = st.st_size;
+	index->header = map;
+	index->entries = (const app_info_index_entry_s *)((const char *)map + index->header->entries_offset);
+	index->sorted = (const uint32_t *)((const char *)map + index->header->sorted_offset);
+	index->strings = (const char *)map + index->header->strings_offset;
+
+	return index;
+}
+
+static void app_info_index_drop_locked(void)
+{
+	if (app_info_index != NULL)
+	{
+		app_info_index_release(app_info_index);
+		app_info_index = NULL;
+	}
+}
+
+// a missing, outdated or broken index is rebuilt by the first process that needs it
+static app_info_index_s *app_info_index_load(const char *path)
+{
+	app_info_index_stamp_s stamp;
+	app_info_index_s *index = NULL;
+	char *lock_path;
+	int lock_fd = -1;
+
+	if (app_info_index_get_stamp(&stamp) == true)
+	{
+		index = app_info_index_map(path, &stamp);
+
+		if (index != NULL)
+		{
+			return index;
+		}
+	}
+
+	lock_path = g_strdup_printf("%s.lock", path);
+
+	if (lock_path != NULL)
+	{
+		lock_fd = open(lock_path, O_RDWR | O_CREAT, 0644);
+		g_free(lock_path);
+	}
+
+	if (lock_fd >= 0)
+	{
+		flock(lock_fd, LOCK_EX);
+	}
+
+	// the process that held the lock before may have written the file for the same database
+	if (app_info_index_get_stamp(&stamp) == true)
+	{
+		index = app_info_index_map(path, &stamp);
+	}
+
+	if (index == NULL && app_info_index_build(path, &stamp) == APP_MANAGER_ERROR_NONE)
+	{
+		index = app_info_index_map(path, &stamp);
+	}
+
+	if (lock_fd >= 0)
+	{
+		close(lock_fd);
+	}
+
+	if (index == NULL)
+	{
+		LOGE("[%s] failed to load %s", __FUNCTION__, path);
+	}
+
+	return index;
+}
+
+static void app_info_index_package_event_cb(const char *package, package_event_type_e type, package_event_state_e state, int progress, void *user_data)
+{
+	// an operation given up on may have changed the database as well, a file still matching it is mapped again without a rebuild
+	if (state != PACKAGE_EVENT_STATE_COMPLETED && state != PACKAGE_EVENT_STATE_FAILED)
+	{
+		return;
+	}
+
+	pthread_mutex_lock(&app_info_index_mutex);
+
+	// the index is bypassed while packages change and loaded again by the first reader after they all have
+	app_info_index_drop_locked();
+	app_info_index_generation++;
+	app_info_index_retry_time = 0;
+
+	pthread_mutex_unlock(&app_info_index_mutex);
+}
+
+int app_info_index_set_path(const char *path)
+{
+	char *path_dup = NULL;
+	int retval;
+
+	if (path != NULL)
+	{
+		path_dup = strdup(path);
+
+		if (path_dup == NULL)
+		{
+			return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+		}
+	}
+
+	pthread_mutex_lock(&app_info_index_mutex);
+
+	// the index is only trusted while the package events can keep it up to date
+	if (path_dup != NULL && app_info_index_listening == false)
+	{
+		retval = package_event_add_listener(app_info_index_package_event_cb, NULL);
+
+		if (retval != APP_MANAGER_ERROR_NONE)
+		{
+			pthread_mutex_unlock(&app_info_index_mutex);
+			free(path_dup);
+			return app_manager_error(retval, __FUNCTION__, NULL);
+		}
+
+		app_info_index_listening = true;
+	}
+
+	app_info_index_drop_locked();
+	app_info_index_generation++;
+
+	free(app_info_index_path);
+	app_info_index_path = path_dup;
+	app_info_index_retry_time = 0;
+
+	pthread_mutex_unlock(&app_info_index_mutex);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+app_info_index_s *app_info_index_acquire(void)
+{
+	app_info_index_s *index = NULL;
+	app_info_index_s *loaded = NULL;
+	unsigned int generation;
+	char *path = NULL;
+
+	// the listeners registered before ours hear of an operation before the mapping is dropped
+	if (package_event_is_busy() == true)
+	{
+		return NULL;
+	}
+
+	pthread_mutex_lock(&app_info_index_mutex);
+
+	// one reader loads the index without the mutex, the others query the database meanwhile instead of waiting for it
+	if (app_info_index_path != NULL && app_info_index == NULL && app_info_index_loading == false
+			&& app_info_index_now() >= app_info_index_retry_time)
+	{
+		path = strdup(app_info_index_path);
+	}
+
+	if (path != NULL)
+	{
+		app_info_index_loading = true;
+		generation = app_info_index_generation;
+
+		pthread_mutex_unlock(&app_info_index_mutex);
+
+		loaded = app_info_index_load(path);
+		free(path);
+
+		pthread_mutex_lock(&app_info_index_mutex);
+
+		app_info_index_loading = false;
+
+		// an index loaded across a package operation or a new path is thrown away
+		if (generation == app_info_index_generation && app_info_index == NULL)
+		{
+			app_info_index = loaded;
+			loaded = NULL;
+
+			if (app_info_index == NULL)
+			{
+				app_info_index_retry_time = app_info_index_now() + APP_INFO_INDEX_RETRY_INTERVAL;
+			}
+		}
+	}
+
+	if (app_info_index != NULL)
+	{
+		index = app_info_index;
+		g_atomic_int_inc(&(index->ref_count));
+	}
+
+	pthread_mutex_unlock(&app_info_index_mutex);
+
+	app_info_index_release(loaded);
+
+	return index;
+}
+
+app_info_index_s *app_info_index_ref(app_info_index_s *index)
+{
+	g_atomic_int_inc(&(index->ref_count));
+
+	return index;
+}
+
+void app_info_index_release(app_info_index_s *index)
+{
+	if (index != NULL && g_atomic_int_dec_and_test(&(index->ref_count)))
+	{
+		munmap(index->map, index->size);
+		free(index);
+	}
+}
+
+int app_info_index_get_count(app_info_index_s *index)
+{
+	return index->header->count;
+}
+
+const app_info_index_entry_s *app_info_index_get_entry(app_info_index_s *index, int position)
+{
+	return &(index->entries[position]);
+}
+
+const app_info_index_entry_s *app_info_index_lookup(app_info_index_s *index, const char *app_id)
+{
+	const app_info_index_entry_s *entry;
+	int lower = 0;
+	int upper = index->header->count - 1;
+	int middle;
+	int order;
+
+	while (lower <= upper)
+	{
+		middle = lower + (upper - lower) / 2;
+		entry = &(index->entries[index->sorted[middle]]);
+		order = strcmp(app_id, index->strings + entry->app_id);
+
+		if (order == 0)
+		{
+			return entry;
+		}
+		else if (order < 0)
+		{
+			upper = middle - 1;
+		}
+		else
+		{
+			lower = middle + 1;
+		}
+	}
+
+	return NULL;
+}
+
+const char *app_info_index_get_app_id(app_info_index_s *index, const app_info_index_entry_s *entry)
+{
+	return index->strings + entry->app_id;
+}
+
+// NULL where AIL has no value, so the caller fails as it would on the row
+const char *app_info_index_get_field(app_info_index_s *index, const app_info_index_entry_s *entry, app_info_index_field_e field)
+{
+	if (entry->fields[field] == APP_INFO_INDEX_ABSENT)
+	{
+		return NULL;
+	}
+
+	return index->strings + entry->fields[field];
+}
+
+int app_info_index_get_flags(const app_info_index_entry_s *entry)
+{
+	return entry->flags;
+}
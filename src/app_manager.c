@@ -99,6 +99,71 @@ void app_manager_unset_app_context_event_cb(void)
 	app_context_unset_event_cb();
 }
 
+int app_manager_subscribe_app_context_event(const char *app_id_prefix, int events,
+		app_manager_app_context_event_cb callback, void *user_data, app_context_subscription_h *subscription)
+{
+	int retval;
+
+	retval = app_context_subscribe_event(app_id_prefix, events, callback, user_data, subscription);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_unsubscribe_app_context_event(app_context_subscription_h subscription)
+{
+	int retval;
+
+	retval = app_context_unsubscribe_event(subscription);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_set_app_context_event_dispatch_mode(app_manager_event_dispatch_mode_e mode)
+{
+	int retval;
+
+	retval = app_context_set_event_dispatch_mode(mode);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_get_app_context_event_stats(unsigned int *dispatched, unsigned int *coalesced, unsigned int *dropped)
+{
+	int retval;
+
+	retval = app_context_get_event_stats(dispatched, coalesced, dropped);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
 int app_manager_foreach_app_context(app_manager_app_context_cb callback, void *user_data)
 {
 	int retval;
@@ -115,6 +180,22 @@ int app_manager_foreach_app_context(app_manager_app_context_cb callback, void *u
 	}
 }
 
+int app_manager_get_running_app_snapshot(app_context_snapshot_h *snapshot)
+{
+	int retval;
+
+	retval = app_context_get_snapshot(snapshot);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
 int app_manager_get_app_context(const char *app_id, app_context_h *app_context)
 {
 	int retval;
@@ -133,14 +214,14 @@ int app_manager_get_app_context(const char *app_id, app_context_h *app_context)
 
 int app_manager_resume_app(app_context_h app_context)
 {
-	char *app_id;
+	const char *app_id;
 
 	if (app_context == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (app_context_get_app_id(app_context, &app_id) != APP_MANAGER_ERROR_NONE)
+	if (app_context_get_app_id_peek(app_context, &app_id) != APP_MANAGER_ERROR_NONE)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, "failed to get the application ID");
 	}
@@ -171,6 +252,48 @@ void app_manager_unset_app_info_event_cb(void)
 	app_info_unset_event_cb();
 }
 
+int app_manager_set_app_info_progress_cb(app_manager_app_info_progress_cb callback, void *user_data)
+{
+	int retval;
+
+	retval = app_info_set_progress_cb(callback, user_data);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+void app_manager_unset_app_info_progress_cb(void)
+{
+	app_info_unset_progress_cb();
+}
+
+int app_manager_set_app_info_batch_event_cb(unsigned int window, app_manager_app_info_batch_event_cb callback, void *user_data)
+{
+	int retval;
+
+	retval = app_info_set_batch_event_cb(window, callback, user_data);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+void app_manager_unset_app_info_batch_event_cb(void)
+{
+	app_info_unset_batch_event_cb();
+}
+
 
 int app_manager_foreach_app_info(app_manager_app_info_cb callback, void *user_data)
 {
@@ -188,6 +311,38 @@ int app_manager_foreach_app_info(app_manager_app_info_cb callback, void *user_da
 	}
 }
 
+int app_manager_foreach_app_info_by_filter(app_info_filter_h filter, app_manager_app_info_cb callback, void *user_data)
+{
+	int retval;
+
+	retval = app_info_foreach_app_info_by_filter(filter, callback, user_data);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_count_app_info_by_filter(app_info_filter_h filter, int *count)
+{
+	int retval;
+
+	retval = app_info_count_app_info_by_filter(filter, count);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
 int app_manager_get_app_info(const char *app_id, app_info_h *app_info)
 {
 	int retval;
@@ -204,6 +359,110 @@ int app_manager_get_app_info(const char *app_id, app_info_h *app_info)
 	}
 }
 
+int app_manager_get_app_property(const char *app_id, app_info_property_e property, char *buffer, int size)
+{
+	int retval;
+
+	retval = app_info_get_app_property(app_id, property, buffer, size);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_get_app_info_table(const char **app_ids, int count, int properties, app_info_table_h *table)
+{
+	int retval;
+
+	retval = app_info_get_app_info_table(app_ids, count, properties, table);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_get_app_info_cache_stats(unsigned int *hits, unsigned int *misses)
+{
+	int retval;
+
+	retval = app_info_get_cache_stats(hits, misses);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_set_app_info_index_path(const char *path)
+{
+	int retval;
+
+	retval = app_info_index_set_path(path);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
+int app_manager_get_handle_pool_stats(app_manager_handle_type_e type, app_manager_handle_pool_stats_s *stats)
+{
+	if (stats == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	switch (type)
+	{
+	case APP_MANAGER_HANDLE_TYPE_APP_CONTEXT:
+		app_context_get_pool_stats(stats);
+		break;
+
+	case APP_MANAGER_HANDLE_TYPE_APP_INFO:
+		app_info_get_pool_stats(stats);
+		break;
+
+	default:
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, "invalid handle type");
+	}
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int app_manager_get_app_context_by_pid(pid_t pid, app_context_h *app_context)
+{
+	int retval;
+
+	retval = app_context_get_app_context_by_pid(pid, app_context);
+
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+}
+
 int app_manager_get_package(pid_t pid, char **package)
 {
 	// TODO: this function must be deprecated
@@ -212,30 +471,27 @@ int app_manager_get_package(pid_t pid, char **package)
 
 int app_manager_get_app_id(pid_t pid, char **app_id)
 {
-	char buffer[256] = {0, };
-	char *app_id_dup = NULL;
+	int retval;
 
 	if (app_id == NULL)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
 	}
 
-	if (aul_app_get_pkgname_bypid(pid, buffer, sizeof(buffer)) != AUL_R_OK)
+	retval = app_context_get_app_id_by_pid(pid, app_id);
+
+	if (retval == APP_MANAGER_ERROR_NO_SUCH_APP)
 	{
 		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, "Invalid process ID");
 	}
-
-	app_id_dup = strdup(buffer);
-
-	if (app_id_dup == NULL)
+	else if (retval != APP_MANAGER_ERROR_NONE)
 	{
-		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, NULL);
+		return app_manager_error(retval, __FUNCTION__, NULL);
+	}
+	else
+	{
+		return APP_MANAGER_ERROR_NONE;
 	}
-
-	*app_id = app_id_dup;
-
-	return APP_MANAGER_ERROR_NONE;
-
 }
 
 int app_manager_terminate_app(app_context_h app_context)
@@ -270,7 +526,5 @@ int app_manager_is_running(const char *app_id, bool *running)
 		return APP_MANAGER_ERROR_INVALID_PARAMETER;
 	}
 
-	*running = aul_app_is_running(app_id);
-
-	return APP_MANAGER_ERROR_NONE;
+	return app_context_is_running(app_id, running);
 }
@@ -19,12 +19,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <pthread.h>
+
+#include <glib.h>
 
 #include <aul.h>
 #include <aul_service.h>
 #include <vconf.h>
 #include <ail.h>
-#include <package-manager.h>
 #include <dlog.h>
 
 #include <app_manager.h>
@@ -47,15 +49,101 @@ typedef struct {
 	void *user_data;
 } installed_apps_foreach_cb_context;
 
-static pkgmgr_client *package_manager = NULL;
 static app_manager_app_list_changed_cb app_list_changed_cb = NULL;
 static void *app_list_changed_cb_data = NULL;
 
+static pthread_mutex_t task_manage_table_mutex = PTHREAD_MUTEX_INITIALIZER;
+static GHashTable *task_manage_table = NULL;
+static unsigned int task_manage_generation = 0;
+
+static int app_manager_start_package_manager(void);
+
+// on a miss, the generation is handed back to app_manager_store_task_manage() to spot an invalidation in between
+static bool app_manager_lookup_task_manage(const char *package, bool *task_manage, unsigned int *generation)
+{
+	gpointer value;
+	bool found = false;
+
+	pthread_mutex_lock(&task_manage_table_mutex);
+
+	if (task_manage_table != NULL && g_hash_table_lookup_extended(task_manage_table, package, NULL, &value))
+	{
+		*task_manage = GPOINTER_TO_INT(value);
+		found = true;
+	}
+
+	pthread_mutex_unlock(&task_manage_table_mutex);
+
+	// the listener has to be up before the generation is taken, or an invalidation could slip by unseen
+	if (found == false)
+	{
+		app_manager_start_package_manager();
+
+		pthread_mutex_lock(&task_manage_table_mutex);
+		*generation = task_manage_generation;
+		pthread_mutex_unlock(&task_manage_table_mutex);
+	}
+
+	return found;
+}
+
+static void app_manager_store_task_manage(const char *package, bool task_manage, unsigned int generation)
+{
+	char *package_dup;
+
+	// the flag only stays valid while the package events can drop it
+	if (app_manager_start_package_manager() != APP_MANAGER_ERROR_NONE)
+	{
+		return;
+	}
+
+	package_dup = strdup(package);
+
+	if (package_dup == NULL)
+	{
+		return;
+	}
+
+	pthread_mutex_lock(&task_manage_table_mutex);
+
+	// a flag read across an invalidation may already be stale, so it is not kept
+	if (generation != task_manage_generation)
+	{
+		pthread_mutex_unlock(&task_manage_table_mutex);
+		free(package_dup);
+		return;
+	}
+
+	if (task_manage_table == NULL)
+	{
+		task_manage_table = g_hash_table_new_full(g_str_hash, g_str_equal, free, NULL);
+	}
+
+	g_hash_table_replace(task_manage_table, package_dup, GINT_TO_POINTER(task_manage));
+
+	pthread_mutex_unlock(&task_manage_table_mutex);
+}
+
+static void app_manager_invalidate_task_manage(const char *package)
+{
+	pthread_mutex_lock(&task_manage_table_mutex);
+
+	task_manage_generation++;
+
+	if (task_manage_table != NULL)
+	{
+		g_hash_table_remove(task_manage_table, package);
+	}
+
+	pthread_mutex_unlock(&task_manage_table_mutex);
+}
+
 static int foreach_running_app_cb_broker(const aul_app_info * appcore_app_info, void *appcore_user_data)
 {
 	ail_appinfo_h handle;
 	ail_error_e ret;
 	bool task_manage = false;
+	unsigned int generation;
 	running_apps_foreach_cb_context *foreach_cb_context = NULL;
 
 	if (appcore_app_info == NULL || appcore_user_data == NULL) 
@@ -64,19 +152,29 @@ static int foreach_running_app_cb_broker(const aul_app_info * appcore_app_info,
 		return 0;
 	}
 
-	ret = ail_package_get_appinfo(appcore_app_info->pkg_name, &handle);
-	if (ret != AIL_ERROR_OK)
+	if (app_manager_lookup_task_manage(appcore_app_info->pkg_name, &task_manage, &generation) == false)
 	{
-		LOGE("[%s] DB_FAILED(0x%08x) : failed to get the app-info", __FUNCTION__, APP_MANAGER_ERROR_DB_FAILED);
-		return 0;
-	}
+		ret = ail_package_get_appinfo(appcore_app_info->pkg_name, &handle);
+		if (ret != AIL_ERROR_OK)
+		{
+			LOGE("[%s] DB_FAILED(0x%08x) : failed to get the app-info", __FUNCTION__, APP_MANAGER_ERROR_DB_FAILED);
+			return 0;
+		}
 
-	// do not call callback function when X-SLP-TaskManage is set to false
-	ret = ail_appinfo_get_bool(handle, AIL_PROP_X_SLP_TASKMANAGE_BOOL, &task_manage);
+		ret = ail_appinfo_get_bool(handle, AIL_PROP_X_SLP_TASKMANAGE_BOOL, &task_manage);
+
+		ail_package_destroy_appinfo(handle);
+
+		if (ret != AIL_ERROR_OK)
+		{
+			return 0;
+		}
 
-	ail_package_destroy_appinfo(handle);
+		app_manager_store_task_manage(appcore_app_info->pkg_name, task_manage, generation);
+	}
 
-	if (ret != AIL_ERROR_OK || task_manage == false)
+	// do not call callback function when X-SLP-TaskManage is set to false
+	if (task_manage == false)
 	{
 		return 0;
 	}
@@ -211,39 +309,32 @@ int app_manager_foreach_app_running(app_manager_app_running_cb callback, void *u
 	return APP_MANAGER_ERROR_NONE;
 }
 
-static int app_manager_get_appinfo(const char *package, const char *property, char **value)
+static int app_manager_get_appinfo(const char *package, app_info_property_e property, char **value)
 {
-	ail_error_e ail_error;
-	ail_appinfo_h appinfo;
-	char *appinfo_value;
-	char *appinfo_value_dup;
+	int retval;
 
-	ail_error = ail_package_get_appinfo(package, &appinfo);
-	if (ail_error != AIL_ERROR_OK)
-	{
-		return app_manager_ail_error_handler(ail_error, __FUNCTION__);
-	}
+	// a single property is copied out of the shared app_info row cache
+	retval = app_info_dup_app_property(package, property, value);
 
-	ail_error = ail_appinfo_get_str(appinfo, property, &appinfo_value);
-	if (ail_error != AIL_ERROR_OK)
+	// the errors keep the codes app_manager_ail_error_handler() gave them when AIL was queried here
+	switch (retval)
 	{
-		ail_package_destroy_appinfo(appinfo);
-		return app_manager_ail_error_handler(ail_error, __FUNCTION__);
-	}
+	case APP_MANAGER_ERROR_NONE:
+		return APP_MANAGER_ERROR_NONE;
 
-	appinfo_value_dup = strdup(appinfo_value);
+	case APP_MANAGER_ERROR_NO_SUCH_APP:
+		LOGE("[%s] INVALID_PACKAGE(0x%08x)", __FUNCTION__, APP_MANAGER_ERROR_INVALID_PACKAGE);
+		return APP_MANAGER_ERROR_INVALID_PACKAGE;
 
-	ail_package_destroy_appinfo(appinfo);
+	case APP_MANAGER_ERROR_DB_FAILED:
+		return app_manager_ail_error_handler(AIL_ERROR_DB_FAILED, __FUNCTION__);
 
-	if (appinfo_value_dup == NULL)
-	{
-		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, APP_MANAGER_ERROR_OUT_OF_MEMORY);
-		return APP_MANAGER_ERROR_OUT_OF_MEMORY;
-	}
+	case APP_MANAGER_ERROR_OUT_OF_MEMORY:
+		return app_manager_ail_error_handler(AIL_ERROR_OUT_OF_MEMORY, __FUNCTION__);
 
-	*value = appinfo_value_dup;
-	
-	return APP_MANAGER_ERROR_NONE;
+	default:
+		return app_manager_ail_error_handler(AIL_ERROR_FAIL, __FUNCTION__);
+	}
 }
 
 int app_manager_get_app_name(const char *package, char** name)
@@ -254,7 +345,7 @@ int app_manager_get_app_name(const char *package, char** name)
 		return APP_MANAGER_ERROR_INVALID_PARAMETER;
 	}
 
-	return app_manager_get_appinfo(package, AIL_PROP_NAME_STR, name);
+	return app_manager_get_appinfo(package, APP_INFO_PROPERTY_NAME, name);
 }
  
 int app_manager_get_app_icon_path(const char *package, char** icon_path)
@@ -265,7 +356,7 @@ int app_manager_get_app_icon_path(const char *package, char** icon_path)
 		return APP_MANAGER_ERROR_INVALID_PARAMETER;
 	}
 
-	return app_manager_get_appinfo(package, AIL_PROP_ICON_STR, icon_path);
+	return app_manager_get_appinfo(package, APP_INFO_PROPERTY_ICON, icon_path);
 }
 
 int app_manager_get_app_version(const char *package, char** version)
@@ -276,72 +367,82 @@ int app_manager_get_app_version(const char *package, char** version)
 		return APP_MANAGER_ERROR_INVALID_PARAMETER;
 	}
 
-	return app_manager_get_appinfo(package, AIL_PROP_VERSION_STR, version);
+	return app_manager_get_appinfo(package, APP_INFO_PROPERTY_VERSION, version);
 }
 
-static app_manger_event_type_e app_manager_app_list_pkgmgr_event(const char *value)
+static app_manger_event_type_e app_manager_app_list_pkgmgr_event(package_event_type_e type)
 {
-	if (!strcasecmp(value, "install"))
+	switch (type)
 	{
+	case PACKAGE_EVENT_TYPE_INSTALL:
 		return APP_MANAGER_EVENT_INSTALLED;
+
+	case PACKAGE_EVENT_TYPE_UNINSTALL:
+		return APP_MANAGER_EVENT_UNINSTALLED;
+
+	case PACKAGE_EVENT_TYPE_UPDATE:
+		return APP_MANAGER_EVENT_UPDATED;
+
+	default:
+		return APP_MANAGER_ERROR_INVALID_PARAMETER;
 	}
-	else if (!strcasecmp(value, "uninstall"))
-	{
-		return APP_MANAGER_EVENT_UNINSTALLED;	
-	}
-	else if (!strcasecmp(value, "update"))
+}
+
+static void app_manager_app_list_changed_cb_broker(const char *package, package_event_type_e type, package_event_state_e state, int progress, void *data)
+{
+	app_manager_app_list_changed_cb callback = app_list_changed_cb;
+	app_manger_event_type_e event_type = app_manager_app_list_pkgmgr_event(type);
+
+	if (package == NULL)
 	{
-		return APP_MANAGER_EVENT_UPDATED;		
+		return;
 	}
-	else
+
+	app_manager_invalidate_task_manage(package);
+
+	if (state == PACKAGE_EVENT_STATE_COMPLETED && callback != NULL && event_type >= 0)
 	{
-		return APP_MANAGER_ERROR_INVALID_PARAMETER;
+		callback(event_type, package, app_list_changed_cb_data);
 	}
 }
 
-static int app_manager_app_list_changed_cb_broker(int id, const char *type, const char *package, const char *key, const char *val, const void *msg, void *data)
+static volatile int app_manager_package_manager_listening = 0;
+
+// registering takes the hub mutex, which would serialize every task-manage miss once the listener is up
+static int app_manager_start_package_manager(void)
 {
-	static int event_id = -1;
-	static app_manger_event_type_e event_type;
+	int retval;
 
-	if (!strcasecmp(key, "start"))
+	if (g_atomic_int_get(&app_manager_package_manager_listening))
 	{
-		event_id = id;
-		event_type = app_manager_app_list_pkgmgr_event(val);
+		return APP_MANAGER_ERROR_NONE;
 	}
-	else if (!strcasecmp(key, "end") && !strcasecmp(val, "ok") && id == event_id)
-	{
-		if (app_list_changed_cb != NULL && event_type >= 0)
-		{
-			app_list_changed_cb(event_type, package, app_list_changed_cb_data);
-		}
 
-		event_id = -1;
-		event_type = -1;
+	retval = package_event_add_listener(app_manager_app_list_changed_cb_broker, NULL);
+
+	if (retval == APP_MANAGER_ERROR_NONE)
+	{
+		g_atomic_int_set(&app_manager_package_manager_listening, 1);
 	}
 
-	return APP_MANAGER_ERROR_NONE;
+	return retval;
 }
 
 int app_manager_set_app_list_changed_cb(app_manager_app_list_changed_cb callback, void* user_data)
 {
+	int retval;
+
        if (callback == NULL) 
 	{
 		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, APP_MANAGER_ERROR_INVALID_PARAMETER);
 		return APP_MANAGER_ERROR_INVALID_PARAMETER;
 	}
 
-	if (app_list_changed_cb == NULL)
-	{
-		package_manager = pkgmgr_client_new(PC_LISTENING);
-
-		if (package_manager == NULL)
-		{
-			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, APP_MANAGER_ERROR_OUT_OF_MEMORY);
-			return APP_MANAGER_ERROR_OUT_OF_MEMORY;
-		}
+	retval = app_manager_start_package_manager();
 
-		pkgmgr_client_listen_status(package_manager, app_manager_app_list_changed_cb_broker, NULL);
+	if (retval != APP_MANAGER_ERROR_NONE)
+	{
+		return retval;
 	}
 
 	app_list_changed_cb = callback;
@@ -352,15 +453,9 @@ int app_manager_set_app_list_changed_cb(app_manager_app_list_changed_cb callback
 
 int app_manager_unset_app_list_changed_cb()
 {	
-	if (app_list_changed_cb != NULL)
-	{
-		pkgmgr_client_free(package_manager);
-		package_manager = NULL;
-	}
-
+	// the listener stays, the cached X-SLP-TaskManage flags still depend on it
 	app_list_changed_cb = NULL;
 	app_list_changed_cb_data = NULL;
 
 	return APP_MANAGER_ERROR_NONE;
 }
-
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <app_manager.h>
+#include <app_manager_private.h>
+
+/*
+ * Handles are carved out of slabs that are never given back to the system. A released handle
+ * is pushed on the free list through its first word, so taking and releasing one is a pointer
+ * swap under the pool mutex once the pool has grown to the working set of the process.
+ */
+typedef struct _handle_pool_slab_ {
+	struct _handle_pool_slab_ *next;
+} handle_pool_slab_s;
+
+typedef struct _handle_pool_free_ {
+	struct _handle_pool_free_ *next;
+} handle_pool_free_s;
+
+// keep every element as aligned as malloc() would
+#define HANDLE_POOL_ALIGN (sizeof(void *) * 2)
+
+static size_t handle_pool_align(size_t size)
+{
+	return (size + HANDLE_POOL_ALIGN - 1) & ~(HANDLE_POOL_ALIGN - 1);
+}
+
+static int handle_pool_grow(handle_pool_s *pool)
+{
+	size_t element_size = handle_pool_align(pool->element_size > sizeof(handle_pool_free_s) ? pool->element_size : sizeof(handle_pool_free_s));
+	size_t header_size = handle_pool_align(sizeof(handle_pool_slab_s));
+	handle_pool_slab_s *slab;
+	handle_pool_free_s *element;
+	int i;
+
+	slab = malloc(header_size + element_size * HANDLE_POOL_SLAB_SIZE);
+
+	if (slab == NULL)
+	{
+		return APP_MANAGER_ERROR_OUT_OF_MEMORY;
+	}
+
+	slab->next = pool->slabs;
+	pool->slabs = slab;
+
+	for (i = HANDLE_POOL_SLAB_SIZE - 1; i >= 0; i--)
+	{
+		element = (handle_pool_free_s *)((char *)slab + header_size + element_size * i);
+		element->next = pool->free_list;
+		pool->free_list = element;
+	}
+
+	pool->slab_count++;
+	pool->capacity += HANDLE_POOL_SLAB_SIZE;
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+void *handle_pool_take(handle_pool_s *pool)
+{
+	handle_pool_free_s *element;
+
+	pthread_mutex_lock(&pool->mutex);
+
+	if (pool->free_list == NULL && handle_pool_grow(pool) != APP_MANAGER_ERROR_NONE)
+	{
+		pthread_mutex_unlock(&pool->mutex);
+		return NULL;
+	}
+
+	element = pool->free_list;
+	pool->free_list = element->next;
+
+	pool->in_use++;
+
+	if (pool->in_use > pool->peak)
+	{
+		pool->peak = pool->in_use;
+	}
+
+	pool->takes++;
+
+	pthread_mutex_unlock(&pool->mutex);
+
+	memset(element, 0, pool->element_size);
+
+	return element;
+}
+
+void handle_pool_release(handle_pool_s *pool, void *element)
+{
+	handle_pool_free_s *released = element;
+
+	if (element == NULL)
+	{
+		return;
+	}
+
+	pthread_mutex_lock(&pool->mutex);
+
+	released->next = pool->free_list;
+	pool->free_list = released;
+
+	pool->in_use--;
+
+	pthread_mutex_unlock(&pool->mutex);
+}
+
+void handle_pool_get_stats(handle_pool_s *pool, app_manager_handle_pool_stats_s *stats)
+{
+	pthread_mutex_lock(&pool->mutex);
+
+	stats->slabs = pool->slab_count;
+	stats->capacity = pool->capacity;
+	stats->in_use = pool->in_use;
+	stats->peak = pool->peak;
+	stats->takes = pool->takes;
+
+	pthread_mutex_unlock(&pool->mutex);
+}
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <glib.h>
+
+#include <package-manager.h>
+#include <dlog.h>
+
+#include <app_manager.h>
+#include <app_manager_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_APP_MANAGER"
+
+#define PACKAGE_EVENT_LISTENER_MAX 8
+
+#define PACKAGE_EVENT_PROGRESS_KEY "install_percent"
+
+/*
+ * One pkgmgr client is shared by every internal consumer of the package events. Its status
+ * messages are parsed once here and fanned out as package_event_cb calls. Consumers are only
+ * ever added, so the table is copied under the lock and dispatched over without it.
+ */
+typedef struct _package_event_listener_ {
+	package_event_cb callback;
+	void *user_data;
+} package_event_listener_s;
+
+static pthread_mutex_t package_event_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pkgmgr_client *package_event_client = NULL;
+static package_event_listener_s package_event_listeners[PACKAGE_EVENT_LISTENER_MAX];
+static int package_event_listener_count = 0;
+
+/*
+ * Bulk operations interleave the messages of several requests, so every started operation is
+ * tracked by its request ID and package until its end message arrives, or until it has been
+ * silent for longer than PACKAGE_EVENT_REQUEST_TIMEOUT and is reported as failed. Requests are
+ * only added and expired on the default main context, from the pkgmgr callback and from a
+ * timer that runs while any is in flight. The mutex guards the table against
+ * package_event_is_busy, which reads it from any thread.
+ */
+typedef struct _package_request_ {
+	int id;
+	const char *package;
+	package_event_type_e type;
+	int progress;
+	int last_seen;
+} package_request_s;
+
+static pthread_mutex_t package_request_mutex = PTHREAD_MUTEX_INITIALIZER;
+static GHashTable *package_request_table = NULL;
+static guint package_request_timer = 0;
+
+/*
+ * The hub is busy while a request it has not given up on is in flight and while a message is
+ * being dispatched, so it turns busy before any listener hears of an operation, even one whose
+ * start went by unseen. Readers of state that the operation may change, such as the
+ * application index, check it instead of relying on their own listener, which may run after
+ * the others.
+ */
+static volatile int package_event_dispatching = 0;
+
+static int package_event_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec;
+}
+
+static guint package_request_hash(gconstpointer key)
+{
+	const package_request_s *request = key;
+
+	return g_str_hash(request->package) ^ (guint)request->id;
+}
+
+static gboolean package_request_equal(gconstpointer lhs, gconstpointer rhs)
+{
+	const package_request_s *a = lhs;
+	const package_request_s *b = rhs;
+
+	return a->id == b->id && !strcmp(a->package, b->package);
+}
+
+static void package_request_destroy(gpointer data)
+{
+	package_request_s *request = data;
+
+	free((char *)request->package);
+	free(request);
+}
+
+static package_request_s *package_request_lookup(int id, const char *package)
+{
+	package_request_s key = { .id = id, .package = package };
+
+	if (package_request_table == NULL)
+	{
+		return NULL;
+	}
+
+	return g_hash_table_lookup(package_request_table, &key);
+}
+
+static gboolean package_request_timeout_cb(gpointer data);
+
+static void package_request_start(int id, const char *package, package_event_type_e type, int now)
+{
+	package_request_s *request;
+
+	if (package_request_table == NULL)
+	{
+		package_request_table = g_hash_table_new_full(package_request_hash, package_request_equal, NULL, package_request_destroy);
+	}
+
+	request = calloc(1, sizeof(package_request_s));
+
+	if (request == NULL)
+	{
+		return;
+	}
+
+	request->package = strdup(package);
+
+	if (request->package == NULL)
+	{
+		free(request);
+		return;
+	}
+
+	request->id = id;
+	request->type = type;
+	request->progress = -1;
+	request->last_seen = now;
+
+	// a restarted request replaces its previous state
+	g_hash_table_replace(package_request_table, request, request);
+
+	// no further message may come to expire a request whose end got lost
+	if (package_request_timer == 0)
+	{
+		package_request_timer = g_timeout_add_seconds(PACKAGE_EVENT_REQUEST_TIMEOUT, package_request_timeout_cb, NULL);
+	}
+}
+
+// the expired requests are taken out of the table and handed back to be reported outside of the lock
+static GList *package_request_expire_locked(int now)
+{
+	GHashTableIter iter;
+	gpointer value;
+	package_request_s *request;
+	GList *expired = NULL;
+
+	if (package_request_table == NULL)
+	{
+		return NULL;
+	}
+
+	g_hash_table_iter_init(&iter, package_request_table);
+
+	while (g_hash_table_iter_next(&iter, NULL, &value))
+	{
+		request = value;
+
+		if (now - request->last_seen >= PACKAGE_EVENT_REQUEST_TIMEOUT)
+		{
+			LOGW("[%s] request %d of %s timed out", __FUNCTION__, request->id, request->package);
+			g_hash_table_iter_steal(&iter);
+			expired = g_list_prepend(expired, request);
+		}
+	}
+
+	return expired;
+}
+
+static bool package_request_is_empty_locked(void)
+{
+	return package_request_table == NULL || g_hash_table_size(package_request_table) == 0;
+}
+
+static package_event_type_e package_event_get_type(const char *value)
+{
+	if (!strcasecmp(value, "install"))
+	{
+		return PACKAGE_EVENT_TYPE_INSTALL;
+	}
+	else if (!strcasecmp(value, "uninstall"))
+	{
+		return PACKAGE_EVENT_TYPE_UNINSTALL;
+	}
+	else if (!strcasecmp(value, "update"))
+	{
+		return PACKAGE_EVENT_TYPE_UPDATE;
+	}
+	else
+	{
+		return PACKAGE_EVENT_TYPE_UNKNOWN;
+	}
+}
+
+static void package_event_dispatch(const char *package, package_event_type_e type, package_event_state_e state, int progress)
+{
+	package_event_listener_s listeners[PACKAGE_EVENT_LISTENER_MAX];
+	int count;
+	int i;
+
+	pthread_mutex_lock(&package_event_mutex);
+
+	count = package_event_listener_count;
+	memcpy(listeners, package_event_listeners, count * sizeof(package_event_listener_s));
+
+	pthread_mutex_unlock(&package_event_mutex);
+
+	for (i = 0; i < count; i++)
+	{
+		listeners[i].callback(package, type, state, progress, listeners[i].user_data);
+	}
+}
+
+// the listeners drop what they cached for a package whose operation was given up on, as for any failed one
+static void package_event_report_expired(GList *expired)
+{
+	GList *link;
+	package_request_s *request;
+
+	for (link = expired; link != NULL; link = link->next)
+	{
+		request = link->data;
+		package_event_dispatch(request->package, request->type, PACKAGE_EVENT_STATE_FAILED, 100);
+		package_request_destroy(request);
+	}
+
+	g_list_free(expired);
+}
+
+static gboolean package_request_timeout_cb(gpointer data)
+{
+	GList *expired;
+	bool idle;
+	bool pending;
+
+	g_atomic_int_inc(&package_event_dispatching);
+
+	pthread_mutex_lock(&package_request_mutex);
+
+	expired = package_request_expire_locked(package_event_now());
+	idle = expired != NULL && package_request_is_empty_locked();
+	pending = !package_request_is_empty_locked();
+
+	if (pending == false)
+	{
+		package_request_timer = 0;
+	}
+
+	pthread_mutex_unlock(&package_request_mutex);
+
+	package_event_report_expired(expired);
+
+	if (idle == true)
+	{
+		package_event_dispatch(NULL, PACKAGE_EVENT_TYPE_UNKNOWN, PACKAGE_EVENT_STATE_IDLE, 0);
+	}
+
+	g_atomic_int_dec_and_test(&package_event_dispatching);
+
+	return pending ? TRUE : FALSE;
+}
+
+static int package_event_listener_cb(
+	int id, const char *type, const char *package, const char *key, const char *val, const void *msg, void *data)
+{
+	package_request_s *request;
+	package_event_type_e event_type = PACKAGE_EVENT_TYPE_UNKNOWN;
+	int progress = -1;
+	int now;
+	GList *expired;
+	bool idle = false;
+
+	if (package == NULL || key == NULL || val == NULL)
+	{
+		return APP_MANAGER_ERROR_NONE;
+	}
+
+	now = package_event_now();
+
+	// the start of this request may have gone by before the client listened
+	g_atomic_int_inc(&package_event_dispatching);
+
+	pthread_mutex_lock(&package_request_mutex);
+
+	expired = package_request_expire_locked(now);
+
+	if (!strcasecmp(key, "start"))
+	{
+		event_type = package_event_get_type(val);
+
+		package_request_start(id, package, event_type, now);
+	}
+	else if (!strcasecmp(key, PACKAGE_EVENT_PROGRESS_KEY))
+	{
+		request = package_request_lookup(id, package);
+
+		if (request != NULL)
+		{
+			request->last_seen = now;
+
+			// repeated percentages are not worth a round of callbacks
+			if (atoi(val) != request->progress)
+			{
+				request->progress = atoi(val);
+				event_type = request->type;
+				progress = request->progress;
+			}
+		}
+	}
+	else if (!strcasecmp(key, "end"))
+	{
+		request = package_request_lookup(id, package);
+
+		if (request != NULL)
+		{
+			event_type = request->type;
+			g_hash_table_remove(package_request_table, request);
+		}
+	}
+
+	// pkgmgr has no explicit end of a bulk operation, the last request in flight ending or expiring stands for it
+	idle = (expired != NULL || !strcasecmp(key, "end")) && package_request_is_empty_locked();
+
+	pthread_mutex_unlock(&package_request_mutex);
+
+	package_event_report_expired(expired);
+
+	if (!strcasecmp(key, "start"))
+	{
+		package_event_dispatch(package, event_type, PACKAGE_EVENT_STATE_STARTED, 0);
+	}
+	else if (!strcasecmp(key, PACKAGE_EVENT_PROGRESS_KEY) && progress >= 0)
+	{
+		package_event_dispatch(package, event_type, PACKAGE_EVENT_STATE_PROGRESS, progress);
+	}
+	else if (!strcasecmp(key, "end"))
+	{
+		package_event_dispatch(package, event_type,
+				!strcasecmp(val, "ok") ? PACKAGE_EVENT_STATE_COMPLETED : PACKAGE_EVENT_STATE_FAILED, 100);
+	}
+
+	if (idle == true)
+	{
+		package_event_dispatch(NULL, PACKAGE_EVENT_TYPE_UNKNOWN, PACKAGE_EVENT_STATE_IDLE, 0);
+	}
+
+	g_atomic_int_dec_and_test(&package_event_dispatching);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+int package_event_add_listener(package_event_cb callback, void *user_data)
+{
+	int i;
+
+	if (callback == NULL)
+	{
+		return app_manager_error(APP_MANAGER_ERROR_INVALID_PARAMETER, __FUNCTION__, NULL);
+	}
+
+	pthread_mutex_lock(&package_event_mutex);
+
+	for (i = 0; i < package_event_listener_count; i++)
+	{
+		if (package_event_listeners[i].callback == callback && package_event_listeners[i].user_data == user_data)
+		{
+			pthread_mutex_unlock(&package_event_mutex);
+			return APP_MANAGER_ERROR_NONE;
+		}
+	}
+
+	if (package_event_listener_count == PACKAGE_EVENT_LISTENER_MAX)
+	{
+		pthread_mutex_unlock(&package_event_mutex);
+		return app_manager_error(APP_MANAGER_ERROR_OUT_OF_MEMORY, __FUNCTION__, "too many package event listeners");
+	}
+
+	if (package_event_client == NULL)
+	{
+		package_event_client = pkgmgr_client_new(PC_LISTENING);
+
+		if (package_event_client == NULL)
+		{
+			pthread_mutex_unlock(&package_event_mutex);
+			return app_manager_error(APP_MANAGER_ERROR_IO_ERROR, __FUNCTION__, NULL);
+		}
+
+		pkgmgr_client_listen_status(package_event_client, package_event_listener_cb, NULL);
+	}
+
+	package_event_listeners[package_event_listener_count].callback = callback;
+	package_event_listeners[package_event_listener_count].user_data = user_data;
+	package_event_listener_count++;
+
+	pthread_mutex_unlock(&package_event_mutex);
+
+	return APP_MANAGER_ERROR_NONE;
+}
+
+// a request silent for too long no longer counts, whether or not the main context has expired it yet
+bool package_event_is_busy(void)
+{
+	GHashTableIter iter;
+	gpointer value;
+	package_request_s *request;
+	int now;
+	bool busy = false;
+
+	if (g_atomic_int_get(&package_event_dispatching) != 0)
+	{
+		return true;
+	}
+
+	now = package_event_now();
+
+	pthread_mutex_lock(&package_request_mutex);
+
+	if (package_request_table != NULL)
+	{
+		g_hash_table_iter_init(&iter, package_request_table);
+
+		while (busy == false && g_hash_table_iter_next(&iter, NULL, &value))
+		{
+			request = value;
+			busy = now - request->last_seen < PACKAGE_EVENT_REQUEST_TIMEOUT;
+		}
+	}
+
+	pthread_mutex_unlock(&package_request_mutex);
+
+	return busy;
+}